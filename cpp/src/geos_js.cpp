@@ -1,19 +1,316 @@
 #define GEOS_USE_ONLY_R_API 1
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <geos.h>
+#include <geos/geom/CircularString.h>
 #include <geos/geom/CompoundCurve.h>
 #include <geos/geom/CurvePolygon.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
+#include <geos/shape/fractal/HilbertCode.h>
 #include <geos_c.h>
+#include <string>
 #include <vector>
 #include <wasi/api.h>
+#ifdef GEOS_JS_MALLOC_HOOKS
+#include <cerrno>
+#include <cstdint>
+#include <emscripten/heap.h>
+#include <malloc.h>
+#include <unistd.h>
+#endif
 
 
 typedef uint32_t u32;
 typedef double f64;
 typedef uintptr_t uptr;
 
+// Pointers are exchanged with JS as u32 values and stored in u32 buffer slots
+// (geosify, jsonify, STRtree results...), the JS side indexes memory with
+// `U32`/`F64` views and 32-bit offsets. A Memory64 build would silently
+// truncate them, so it is rejected until the bridge is pointer-width agnostic.
+#ifdef __EMSCRIPTEN__
+static_assert(sizeof(void *) == 4, "geos_js supports wasm32 only, Memory64 (-sMEMORY64) is not supported");
+#endif
+
 extern "C" {
+#ifdef GEOS_JS_MALLOC_HOOKS
+/* ******************************************** *
+ * Allocator hooks: heap stats and job arena
+ * ******************************************** */
+
+/**
+ * `malloc` family is replaced by thin wrappers around the selected allocator
+ * (`emscripten_builtin_*`), that count live allocations and, in builds with
+ * the job arena, serve allocations from the arena region while it is active.
+ */
+f64 liveAllocations = 0; // allocations served by the underlying allocator and not freed yet
+
+#ifdef GEOS_JS_ARENA
+/**
+ * While the arena is active allocations are served from a single region
+ * by bumping an offset, and `free` of region memory is a no-op.
+ * `arena_reset` discards everything at once.
+ * The region is never returned to the underlying allocator, so late `free`
+ * calls with stale region pointers stay no-ops.
+ */
+struct Arena {
+    uint8_t *start;
+    size_t capacity;
+    size_t used;
+    bool active;
+    f64 allocations; // served from the region since the last `arena_begin`
+    f64 fallbacks; // served by the underlying allocator because the region was full
+};
+
+Arena arena = {};
+
+bool arenaContains(const void *ptr) {
+    return (const uint8_t *) ptr >= arena.start && (const uint8_t *) ptr < arena.start + arena.capacity;
+}
+
+/** Allocation size is stored in 8 bytes before the returned pointer, for `realloc` */
+void *arenaAlloc(size_t size, size_t alignment) {
+    if (!arena.active) return nullptr;
+    if (alignment < 16) alignment = 16;
+    const uptr base = (uptr) arena.start;
+    const uptr ptr = (base + arena.used + 8 + alignment - 1) & ~(uptr) (alignment - 1);
+    if (size > arena.capacity || ptr + size > base + arena.capacity) { // first check guards the sum from wrapping
+        arena.fallbacks++;
+        return nullptr;
+    }
+    ((size_t *) ptr)[-1] = size;
+    arena.used = ptr + size - base;
+    arena.allocations++;
+    return (void *) ptr;
+}
+#else
+constexpr bool arenaContains(const void *) { return false; }
+constexpr void *arenaAlloc(size_t, size_t) { return nullptr; }
+#endif
+
+void *counted(void *ptr) {
+    if (ptr) liveAllocations++;
+    return ptr;
+}
+
+void *malloc(size_t size) {
+    void *ptr = arenaAlloc(size, 16);
+    return ptr ? ptr : counted(emscripten_builtin_malloc(size));
+}
+
+void *calloc(size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    void *ptr = arenaAlloc(count * size, 16);
+    if (ptr) return memset(ptr, 0, count * size); // region is reused, not zeroed
+    return counted(emscripten_builtin_calloc(count, size));
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (arenaContains(ptr)) {
+        void *copy = malloc(size);
+        if (copy) {
+            memcpy(copy, ptr, std::min(size, ((size_t *) ptr)[-1]));
+        }
+        return copy;
+    }
+    void *result = emscripten_builtin_realloc(ptr, size);
+    if (!ptr && result) liveAllocations++;
+    else if (ptr && !size && !result) liveAllocations--; // freed
+    return result;
+}
+
+void *memalign(size_t alignment, size_t size) {
+    void *ptr = arenaAlloc(size, alignment);
+    return ptr ? ptr : counted(emscripten_builtin_memalign(alignment, size));
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) {
+    void *ptr = memalign(alignment, size);
+    if (!ptr) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+void free(void *ptr) {
+    if (ptr && !arenaContains(ptr)) {
+        emscripten_builtin_free(ptr);
+        liveAllocations--;
+    }
+}
+
+/**
+ * Returns `mallinfo`-style stats of the underlying allocator.
+ *
+ * Largest free block is a lower bound: the free top of the heap together
+ * with the memory not yet claimed from `WebAssembly.Memory`, free chunks
+ * inside the heap may be larger.
+ *
+ * @return [heapSize, inUse, free, freeChunks, largestFree, allocations]
+ */
+const f64 *heap_stats() {
+    static f64 stats[6];
+    const struct mallinfo info = mallinfo();
+    const size_t unclaimed = emscripten_get_heap_size() - (uptr) sbrk(0);
+    stats[0] = info.arena;
+    stats[1] = info.uordblks;
+    stats[2] = info.fordblks + unclaimed;
+    stats[3] = info.ordblks;
+    stats[4] = info.keepcost + unclaimed;
+    stats[5] = liveAllocations;
+    return stats;
+}
+
+#ifdef GEOS_JS_ARENA
+/**
+ * Starts serving allocations from the arena region.
+ *
+ * @param capacity - region size in bytes, used only by the first call, the
+ * region is reused afterward
+ * @return 1 on success, 0 when the region could not be allocated
+ */
+u32 arena_begin(u32 capacity) {
+    if (!arena.start) {
+        arena.start = (uint8_t *) emscripten_builtin_memalign(16, capacity);
+        if (!arena.start) return 0;
+        arena.capacity = capacity;
+    }
+    arena.used = 0;
+    arena.allocations = 0;
+    arena.fallbacks = 0;
+    arena.active = true;
+    return 1;
+}
+
+/** Stops serving allocations from the arena, all memory allocated from it is discarded */
+void arena_reset() {
+    arena.active = false;
+    arena.used = 0;
+}
+
+/** @return [capacity, used, allocations, fallbacks] */
+const f64 *arena_stats() {
+    static f64 stats[4];
+    stats[0] = arena.capacity;
+    stats[1] = arena.used;
+    stats[2] = arena.allocations;
+    stats[3] = arena.fallbacks;
+    return stats;
+}
+#endif
+#endif
+
+extern "C++" { // templates cannot have C linkage
+#ifdef GEOS_JS_ARENA
+/**
+ * Allocator of the reusable buffers of spatial indexes, which can outlive
+ * the arena. Buffers of indexes created outside the arena never grow into
+ * the arena region, even when the index is queried while the arena is
+ * active, so they are not handed out again after `arena_reset`.
+ */
+template<typename T>
+struct IndexAllocator {
+    using value_type = T;
+    bool persistent; // owner created outside the arena, allocations bypass it
+
+    IndexAllocator() : persistent(!arena.active) {}
+
+    template<typename U>
+    IndexAllocator(const IndexAllocator<U> &other) : persistent(other.persistent) {}
+
+    T *allocate(size_t n) {
+        void *ptr = persistent ? counted(emscripten_builtin_malloc(n * sizeof(T))) : malloc(n * sizeof(T));
+        if (!ptr) throw std::bad_alloc();
+        return (T *) ptr;
+    }
+
+    void deallocate(T *ptr, size_t) {
+        if (persistent) {
+            emscripten_builtin_free(ptr);
+            liveAllocations--;
+        } else {
+            free(ptr);
+        }
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const IndexAllocator<T> &a, const IndexAllocator<U> &b) { return a.persistent == b.persistent; }
+
+template<typename T, typename U>
+bool operator!=(const IndexAllocator<T> &a, const IndexAllocator<U> &b) { return a.persistent != b.persistent; }
+
+template<typename T>
+using IndexVector = std::vector<T, IndexAllocator<T>>;
+#else
+template<typename T>
+using IndexVector = std::vector<T>;
+#endif
+}
+
+
+/* ******************************************** *
+ * Runtime state
+ * ******************************************** */
+
+/**
+ * GEOS context and the JS side reusable buffer.
+ *
+ * By default they are created on the first `runtime_state` call, made by JS
+ * after `_initialize`, when all the static initializers have already run.
+ * In builds with `GEOS_JS_EVAL_CTORS=ON` they are created by a static
+ * initializer instead, which is evaluated at build time, so both are already
+ * in the data segments of the module. This relies on GEOS keeping its
+ * statics in function-local variables, independent of the initialization
+ * order, which is not verified for every GEOS version, hence opt-in.
+ */
+struct RuntimeState {
+    GEOSContextHandle_t ctx;
+    void *buff;
+};
+
+constexpr size_t RUNTIME_BUFF_SIZE =
+    4096 + // buff, keep in sync with `buffLen` in geos.mts
+    2 * 4 + // u32s
+    4 * 8; // f64s
+
+#ifdef GEOS_JS_EVAL_CTORS
+RuntimeState runtimeState = {GEOS_init_r(), malloc(RUNTIME_BUFF_SIZE)};
+#else
+RuntimeState runtimeState = {nullptr, nullptr};
+#endif
+
+/**
+ * Version of the interface between this file and the JS sources: export
+ * signatures and buffer layouts. Bump it together with `ABI_VERSION` in
+ * geos.mts on every change to them, so that JS refuses an outdated module
+ * instead of misreading its buffers.
+ */
+u32 abi_version() {
+    return 1;
+}
+
+/**
+ * @return [ctx, buff]
+ */
+const RuntimeState *runtime_state() {
+#ifndef GEOS_JS_EVAL_CTORS
+    if (!runtimeState.ctx) {
+        runtimeState = {GEOS_init_r(), malloc(RUNTIME_BUFF_SIZE)};
+    }
+#endif
+    return &runtimeState;
+}
+
+
 /* ******************************************** *
  * Geosify: GeoJSON to GEOS
  * ******************************************** */
@@ -248,7 +545,35 @@ GEOSGeometry *geosify_geom(GEOSContextHandle_t ctx, GeosifyState *s) {
     }
 }
 
-void geosify_geoms_r(GEOSContextHandle_t ctx, u32 *buff) {
+void writeEnvelope(const Geometry *geom, f64 *out) {
+    const Envelope *e = geom->getEnvelopeInternal();
+    if (e->isNull()) {
+        out[0] = out[1] = out[2] = out[3] = geos::DoubleNotANumber;
+    } else {
+        out[0] = e->getMinX();
+        out[1] = e->getMinY();
+        out[2] = e->getMaxX();
+        out[3] = e->getMaxY();
+    }
+}
+
+/**
+ * Writes xMin, yMin, xMax, yMax of the envelope to be cached on JS side;
+ * NaN when empty or curved - predicates on curved geometries have to reach GEOS to fail
+ */
+void writeKnownEnvelope(const Geometry *geom, f64 *out) {
+    if (geom && !geom->hasCurvedComponents()) {
+        writeEnvelope(geom, out);
+    } else {
+        out[0] = out[1] = out[2] = out[3] = geos::DoubleNotANumber;
+    }
+}
+
+/**
+ * @param envelopes - [out] Array<f64> 4 values per created geometry,
+ * see `writeKnownEnvelope`
+ */
+void geosify_geoms_r(GEOSContextHandle_t ctx, u32 *buff, f64 *envelopes) {
     const u32 dLength = buff[0];
     const u32 sLength = buff[1];
     u32 *D = buff + 2;
@@ -257,10 +582,21 @@ void geosify_geoms_r(GEOSContextHandle_t ctx, u32 *buff) {
     GeosifyState s = {D, 0, F, 0};
 
     for (u32 o = 0; s.d < dLength; ++o) {
-        D[o] = (uptr) geosify_geom(ctx, &s);
+        GEOSGeometry *geom = geosify_geom(ctx, &s);
+        writeKnownEnvelope((Geometry *) geom, envelopes + o * 4);
+        D[o] = (uptr) geom;
     }
 }
 
+/**
+ * Envelope of a geometry created without one (from WKT, WKB, by operations...).
+ *
+ * @param out - [out] Array<f64> 4 values, see `writeKnownEnvelope`
+ */
+void geom_envelope(const GEOSGeometry *geom, f64 *out) {
+    writeKnownEnvelope((const Geometry *) geom, out);
+}
+
 
 /* ******************************************** *
  * Jsonify: GEOS to GeoJSON
@@ -471,6 +807,14 @@ void jsonify_inspectGeom(const Geometry *geom_cpp, u32 *B, u32 *b, f64 *F, u32 *
     }
 }
 
+/**
+ * Writes geometries in the format read by JS `jsonifyGeom`, right after the
+ * input in the same buffer.
+ *
+ * @param buff - [in] `[0, n, *GEOSGeometry x n, buffAvailableL4]`,
+ * [out] `[0, F index, ...]` when the output fits, otherwise `[neededL4, ...]`
+ * and nothing is written, so that JS can retry with a larger (reused) buffer
+ */
 void jsonify_geoms(u32 *buff) {
     const u32 geomsLength = buff[1];
     const Geometry **geoms_cpp = (const Geometry **) buff + 2;
@@ -481,21 +825,14 @@ void jsonify_geoms(u32 *buff) {
         jsonify_measureGeom(geoms_cpp[i], &bCount, &fCount);
     }
 
-    u32 *B;
-    f64 *F;
     if (bCount + fCount * 2 > buffAvailableL4) {
-        // allocate new tmp output buffer
-        bCount += bCount % 2; // ensure 8 byte alignment for F
-        u32 *tmpOutBuff = (u32 *) malloc(bCount * 4 + fCount * 8);
-        buff[0] = (uptr) tmpOutBuff; // save tmp [out] buffer ptr in [in] buffer
-        B = tmpOutBuff;
-        F = (f64 *) tmpOutBuff + bCount / 2;
-    } else {
-        // use input buffer
-        u32 o = 2 + geomsLength;
-        B = buff + o;
-        F = (f64 *) buff + (o + bCount + 1) / 2;
+        buff[0] = bCount + fCount * 2;
+        return;
     }
+
+    const u32 o = 2 + geomsLength;
+    u32 *B = buff + o;
+    f64 *F = (f64 *) buff + (o + bCount + 1) / 2;
     buff[1] = (uptr) F / 8; // save F index in [in] buffer
 
     u32 b = 0, f = 0;
@@ -509,54 +846,141 @@ void jsonify_geoms(u32 *buff) {
  * STRtree
  * ******************************************** */
 
+typedef geos::index::strtree::TemplateSTRtree<void *> TemplateSTRtree; // what `GEOSSTRtree` really is
+
+struct STRtreeStats {
+    f64 queries;
+    f64 nodesVisited; // inner nodes whose children were tested against the query bbox
+    f64 leafCandidates; // leaf bboxes tested against the query bbox
+    f64 matches; // leaf bboxes that intersected the query bbox, or nearest matches
+    f64 distanceEvaluations; // exact `GEOSDistance_r` calls made by nearest queries
+};
+
 struct STRtree {
     GEOSSTRtree *tree;
     GEOSGeometry **geoms;
+    IndexVector</* geometry index */u32> matches; // reusable query output, valid until the next query
+    STRtreeStats *stats; // nullptr unless requested, queries are not instrumented then
 };
 
-STRtree *STRtree_create_r(GEOSContextHandle_t ctx, GEOSGeometry **geoms, u32 ngeoms, u32 nodeCapacity) {
+STRtree *STRtree_create_r(GEOSContextHandle_t ctx, GEOSGeometry **geoms, u32 ngeoms, u32 nodeCapacity, u32 withStats) {
     GEOSSTRtree *tree = GEOSSTRtree_create_r(ctx, nodeCapacity);
     for (u32 i = 0; i < ngeoms; ++i) {
         // tree item is geometry index, not a pointer to anything
         GEOSSTRtree_insert_r(ctx, tree, geoms[i], (void *) i);
     }
     GEOSSTRtree_build_r(ctx, tree);
-    return new STRtree{tree, geoms};
+    return new STRtree{tree, geoms, {}, withStats ? new STRtreeStats{} : nullptr};
+}
+
+STRtreeStats *STRtree_stats(STRtree *tree) {
+    return tree->stats;
 }
 
 void STRtree_destroy_r(GEOSContextHandle_t ctx, STRtree *tree) {
+#ifdef GEOS_JS_ARENA
+    if (arenaContains(tree)) return; // discarded with the arena, members may be overwritten already
+#endif
     GEOSSTRtree_destroy_r(ctx, tree->tree);
     free(tree->geoms);
+    delete tree->stats;
     delete tree;
 }
 
 
 void queryCallback(void *item, void *userdata) {
-    std::vector<u32> *matches = (std::vector<u32> *) userdata;
+    IndexVector<u32> *matches = (IndexVector<u32> *) userdata;
     matches->push_back((uptr) item); // item is geometry index
 }
 
+void queryNodeCounted(STRtree *tree, const TemplateSTRtree::Node *node, const Envelope &env) {
+    STRtreeStats *stats = tree->stats;
+    stats->nodesVisited++;
+    for (const TemplateSTRtree::Node *child = node->beginChildren(); child < node->endChildren(); ++child) {
+        if (child->isLeaf()) {
+            if (child->isDeleted()) continue;
+            stats->leafCandidates++;
+            if (child->boundsIntersect(env)) {
+                stats->matches++;
+                tree->matches.push_back((uptr) child->getItem());
+            }
+        } else if (child->boundsIntersect(env)) {
+            queryNodeCounted(tree, child, env);
+        }
+    }
+}
+
+/** Same as `TemplateSTRtree::query` but with the tree traversal recorded in `tree->stats` */
+void queryCounted(STRtree *tree, const Envelope &env) {
+    STRtreeStats *stats = tree->stats;
+    stats->queries++;
+    const TemplateSTRtree::Node *root = ((TemplateSTRtree *) tree->tree)->getRoot();
+    if (!root || root->isDeleted()) return;
+    if (root->isLeaf()) { // single item tree
+        stats->leafCandidates++;
+        if (root->boundsIntersect(env)) {
+            stats->matches++;
+            tree->matches.push_back((uptr) root->getItem());
+        }
+    } else if (root->boundsIntersect(env)) {
+        queryNodeCounted(tree, root, env);
+    }
+}
+
 u32 *STRtree_query_r(GEOSContextHandle_t ctx, STRtree *tree, GEOSGeometry *geom, u32 *matchesLength) {
-    std::vector</* geometry index */u32> matches;
-    GEOSSTRtree_query_r(ctx, tree->tree, geom, queryCallback, &matches);
+    tree->matches.clear();
+    if (tree->stats) {
+        queryCounted(tree, *((Geometry *) geom)->getEnvelopeInternal());
+    } else {
+        GEOSSTRtree_query_r(ctx, tree->tree, geom, queryCallback, &tree->matches);
+    }
+    *matchesLength = tree->matches.size();
+    return tree->matches.data();
+}
 
-    const u32 n = matches.size();
-    *matchesLength = n;
-    if (n) {
-        u32 *arr = (u32 *) malloc(n * sizeof(u32)); // caller must free
-        std::memcpy(arr, matches.data(), n * sizeof(u32));
-        return arr;
+void queryBBox(STRtree *tree, f64 xMin, f64 yMin, f64 xMax, f64 yMax) {
+    const Envelope env(xMin, xMax, yMin, yMax);
+    if (tree->stats) {
+        queryCounted(tree, env);
+        return;
+    }
+    IndexVector<u32> &matches = tree->matches;
+    ((TemplateSTRtree *) tree->tree)->query(env, [&matches](void *item) {
+        matches.push_back((uptr) item); // item is geometry index
+    });
+}
+
+u32 *STRtree_queryBBox_r(GEOSContextHandle_t ctx, STRtree *tree, f64 xMin, f64 yMin, f64 xMax, f64 yMax, u32 *matchesLength) {
+    tree->matches.clear();
+    queryBBox(tree, xMin, yMin, xMax, yMax);
+    *matchesLength = tree->matches.size();
+    return tree->matches.data();
+}
+
+/**
+ * @param bboxes - [in] Array<f64> `n` boxes as [xMin, yMin, xMax, yMax, ...]
+ * @param matchesLength - [out] total number of u32 written to the result
+ * @return [n + 1 offsets][matches], offsets are relative to the matches start
+ */
+u32 *STRtree_queryBBoxes_r(GEOSContextHandle_t ctx, STRtree *tree, const f64 *bboxes, u32 n, u32 *matchesLength) {
+    IndexVector<u32> &matches = tree->matches;
+    matches.assign(n + 1, 0);
+    for (u32 i = 0; i < n; ++i, bboxes += 4) {
+        queryBBox(tree, bboxes[0], bboxes[1], bboxes[2], bboxes[3]);
+        matches[i + 1] = matches.size() - (n + 1);
     }
-    return nullptr;
+    *matchesLength = matches.size();
+    return matches.data();
 }
 
 
 struct STRtreeNearestState {
     GEOSContextHandle_t ctx;
     GEOSGeometry **geoms;
+    IndexVector</* geometry index */u32> &matches;
+    STRtreeStats *stats;
     bool allMatches = false; // whether to return all equally distant neighbors, not just the first one
     f64 minDistance = geos::DoubleInfinity;
-    std::vector</* geometry index */u32> matches;
 };
 
 int distanceCallback(const void *item1, const void *item2, double *distance, void *userdata) {
@@ -567,6 +991,9 @@ int distanceCallback(const void *item1, const void *item2, double *distance, voi
 
     double dist;
     GEOSDistance_r(s->ctx, queryGeom, treeGeom, &dist);
+    if (s->stats) {
+        s->stats->distanceEvaluations++;
+    }
 
     if (dist < s->minDistance) {
         s->minDistance = dist;
@@ -585,9 +1012,18 @@ int distanceCallback(const void *item1, const void *item2, double *distance, voi
     return 1;
 }
 
+void nearestCounted(const STRtreeNearestState &s) {
+    if (s.stats) {
+        s.stats->queries++;
+        s.stats->matches += s.allMatches ? s.matches.size() : s.matches.size() > 0;
+    }
+}
+
 u32 STRtree_nearest_r(GEOSContextHandle_t ctx, STRtree *tree, GEOSGeometry *geom, u32 *matchesLength) {
-    STRtreeNearestState s = {ctx, tree->geoms};
+    tree->matches.clear();
+    STRtreeNearestState s = {ctx, tree->geoms, tree->matches, tree->stats};
     GEOSSTRtree_nearest_generic_r(ctx, tree->tree, geom, geom, distanceCallback, &s);
+    nearestCounted(s);
 
     const u32 n = s.matches.size();
     *matchesLength = n;
@@ -598,17 +1034,874 @@ u32 STRtree_nearest_r(GEOSContextHandle_t ctx, STRtree *tree, GEOSGeometry *geom
 }
 
 u32 *STRtree_nearestAll_r(GEOSContextHandle_t ctx, STRtree *tree, GEOSGeometry *geom, u32 *matchesLength) {
-    STRtreeNearestState s = {ctx, tree->geoms, true};
+    tree->matches.clear();
+    STRtreeNearestState s = {ctx, tree->geoms, tree->matches, tree->stats, true};
     GEOSSTRtree_nearest_generic_r(ctx, tree->tree, geom, geom, distanceCallback, &s);
+    nearestCounted(s);
+    *matchesLength = s.matches.size();
+    return s.matches.data();
+}
 
-    const u32 n = s.matches.size();
-    *matchesLength = n;
-    if (n) {
-        u32 *arr = (u32 *) malloc(n * sizeof(u32)); // caller must free
-        std::memcpy(arr, s.matches.data(), n * sizeof(u32));
-        return arr;
+
+/* ******************************************** *
+ * PointGrid
+ * ******************************************** */
+
+struct PointGrid {
+    f64 xMin, yMin;
+    f64 cellSize;
+    int64_t nx, ny;
+    std::vector<u32> cellStart; // [nx * ny + 1] offsets of each cell points in `xy`/`ids`
+    std::vector<f64> xy; // cell-sorted point coordinates
+    std::vector<u32> ids; // cell-sorted point indices in the original input
+    IndexVector</* point index */u32> matches; // reusable query output, valid until the next query
+    IndexVector<std::pair<f64, u32>> heap; // reusable kNN max-heap
+};
+
+/**
+ * @param xy - [in] Array<f64> `n` points as [x, y, x, y, ...], points with
+ * non-finite coordinates are ignored
+ * @param cellSize - when not positive, cell size is picked to hold ~4 points per cell
+ */
+PointGrid *PointGrid_create(const f64 *xy, u32 n, f64 cellSize) {
+    PointGrid *g = new PointGrid{};
+    f64 xMin = geos::DoubleInfinity, yMin = geos::DoubleInfinity;
+    f64 xMax = -geos::DoubleInfinity, yMax = -geos::DoubleInfinity;
+    u32 count = 0;
+    for (u32 i = 0; i < n; ++i) {
+        const f64 x = xy[i * 2], y = xy[i * 2 + 1];
+        if (std::isfinite(x) && std::isfinite(y)) {
+            xMin = std::min(xMin, x);
+            yMin = std::min(yMin, y);
+            xMax = std::max(xMax, x);
+            yMax = std::max(yMax, y);
+            count++;
+        }
+    }
+    if (!count) {
+        xMin = yMin = xMax = yMax = 0;
+    }
+
+    const f64 w = xMax - xMin, h = yMax - yMin;
+    if (!(cellSize > 0)) {
+        cellSize = std::sqrt(w * h / count * 4);
+        if (!(cellSize > 0)) { // all points on a line or at the same spot
+            cellSize = std::max(w, h) / count * 4;
+        }
+        if (!(cellSize > 0)) {
+            cellSize = 1;
+        }
+    }
+    // limit the number of cells to ~4 per point, too many empty cells would only waste memory
+    const f64 maxCells = std::max<f64>(count, 1) * 4;
+    while ((std::floor(w / cellSize) + 1) * (std::floor(h / cellSize) + 1) > maxCells) {
+        cellSize *= 2;
+    }
+
+    g->xMin = xMin;
+    g->yMin = yMin;
+    g->cellSize = cellSize;
+    g->nx = (int64_t) std::floor(w / cellSize) + 1;
+    g->ny = (int64_t) std::floor(h / cellSize) + 1;
+
+    // counting sort of points by cell
+    std::vector<u32> cells(n);
+    g->cellStart.assign(g->nx * g->ny + 1, 0);
+    for (u32 i = 0; i < n; ++i) {
+        const f64 x = xy[i * 2], y = xy[i * 2 + 1];
+        if (std::isfinite(x) && std::isfinite(y)) {
+            const int64_t cx = std::min<int64_t>((x - xMin) / cellSize, g->nx - 1);
+            const int64_t cy = std::min<int64_t>((y - yMin) / cellSize, g->ny - 1);
+            cells[i] = cy * g->nx + cx;
+            g->cellStart[cells[i] + 1]++;
+        }
+    }
+    for (size_t c = 1; c < g->cellStart.size(); ++c) {
+        g->cellStart[c] += g->cellStart[c - 1];
+    }
+    std::vector<u32> next(g->cellStart.begin(), g->cellStart.end() - 1);
+    g->xy.resize(count * 2);
+    g->ids.resize(count);
+    for (u32 i = 0; i < n; ++i) {
+        const f64 x = xy[i * 2], y = xy[i * 2 + 1];
+        if (std::isfinite(x) && std::isfinite(y)) {
+            const u32 j = next[cells[i]]++;
+            g->xy[j * 2] = x;
+            g->xy[j * 2 + 1] = y;
+            g->ids[j] = i;
+        }
+    }
+    return g;
+}
+
+void PointGrid_destroy(PointGrid *g) {
+#ifdef GEOS_JS_ARENA
+    if (arenaContains(g)) return; // discarded with the arena, members may be overwritten already
+#endif
+    delete g;
+}
+
+/** Cell index of the coordinate, not clamped to the grid but to a range that is safe to iterate over */
+int64_t pointGridCell(f64 v, f64 vMin, f64 cellSize) {
+    return (int64_t) std::max(-1e9, std::min(1e9, std::floor((v - vMin) / cellSize)));
+}
+
+extern "C++" { // templates cannot have C linkage
+/** Collects points within [cx0, cx1] x [cy0, cy1] cells for which `test` returns true */
+template<typename Test>
+void pointGridScan(PointGrid *g, int64_t cx0, int64_t cy0, int64_t cx1, int64_t cy1, Test test) {
+    cx0 = std::max<int64_t>(cx0, 0);
+    cy0 = std::max<int64_t>(cy0, 0);
+    cx1 = std::min<int64_t>(cx1, g->nx - 1);
+    cy1 = std::min<int64_t>(cy1, g->ny - 1);
+    for (int64_t cy = cy0; cy <= cy1 && cx0 <= cx1; ++cy) {
+        // cells of one row are contiguous, so the whole row span can be scanned at once
+        const u32 end = g->cellStart[cy * g->nx + cx1 + 1];
+        for (u32 j = g->cellStart[cy * g->nx + cx0]; j < end; ++j) {
+            if (test(g->xy[j * 2], g->xy[j * 2 + 1])) {
+                g->matches.push_back(g->ids[j]);
+            }
+        }
+    }
+}
+}
+
+u32 *PointGrid_queryBBox(PointGrid *g, f64 xMin, f64 yMin, f64 xMax, f64 yMax, u32 *matchesLength) {
+    g->matches.clear();
+    pointGridScan(
+        g,
+        pointGridCell(xMin, g->xMin, g->cellSize), pointGridCell(yMin, g->yMin, g->cellSize),
+        pointGridCell(xMax, g->xMin, g->cellSize), pointGridCell(yMax, g->yMin, g->cellSize),
+        [=](f64 x, f64 y) { return x >= xMin && x <= xMax && y >= yMin && y <= yMax; }
+    );
+    *matchesLength = g->matches.size();
+    return g->matches.data();
+}
+
+u32 *PointGrid_queryRadius(PointGrid *g, f64 x, f64 y, f64 radius, u32 *matchesLength) {
+    g->matches.clear();
+    const f64 r2 = radius * radius;
+    pointGridScan(
+        g,
+        pointGridCell(x - radius, g->xMin, g->cellSize), pointGridCell(y - radius, g->yMin, g->cellSize),
+        pointGridCell(x + radius, g->xMin, g->cellSize), pointGridCell(y + radius, g->yMin, g->cellSize),
+        [=](f64 px, f64 py) { return (px - x) * (px - x) + (py - y) * (py - y) <= r2; }
+    );
+    *matchesLength = g->matches.size();
+    return g->matches.data();
+}
+
+void pointGridNearestInCell(PointGrid *g, int64_t cx, int64_t cy, f64 x, f64 y, u32 k) {
+    IndexVector<std::pair<f64, u32>> &heap = g->heap;
+    const u32 end = g->cellStart[cy * g->nx + cx + 1];
+    for (u32 j = g->cellStart[cy * g->nx + cx]; j < end; ++j) {
+        const f64 dx = g->xy[j * 2] - x, dy = g->xy[j * 2 + 1] - y;
+        const f64 d2 = dx * dx + dy * dy;
+        if (heap.size() < k) {
+            heap.emplace_back(d2, g->ids[j]);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (d2 < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = {d2, g->ids[j]};
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+}
+
+/**
+ * Finds `k` nearest points by visiting grid cells in square rings around the
+ * query point, until no unvisited cell can contain a closer point.
+ * @return point indices sorted by distance
+ */
+u32 *PointGrid_nearest(PointGrid *g, f64 x, f64 y, u32 k, u32 *matchesLength) {
+    g->heap.clear();
+    const int64_t cx = pointGridCell(x, g->xMin, g->cellSize);
+    const int64_t cy = pointGridCell(y, g->yMin, g->cellSize);
+    // rings that do not overlap the grid are empty, skip them
+    const int64_t rMin = std::max<int64_t>({0, -cx, cx - (g->nx - 1), -cy, cy - (g->ny - 1)});
+    const int64_t rMax = std::max<int64_t>({cx, g->nx - 1 - cx, cy, g->ny - 1 - cy});
+    for (int64_t r = rMin; k && r <= rMax; ++r) {
+        const int64_t i0 = std::max<int64_t>(cx - r, 0), i1 = std::min<int64_t>(cx + r, g->nx - 1);
+        const int64_t j0 = std::max<int64_t>(cy - r, 0), j1 = std::min<int64_t>(cy + r, g->ny - 1);
+        for (int64_t j = j0; j <= j1; ++j) {
+            if (j == cy - r || j == cy + r) { // top/bottom row of the ring
+                for (int64_t i = i0; i <= i1; ++i) {
+                    pointGridNearestInCell(g, i, j, x, y, k);
+                }
+            } else { // left/right column of the ring
+                if (cx - r >= 0) pointGridNearestInCell(g, cx - r, j, x, y, k);
+                if (cx + r < g->nx) pointGridNearestInCell(g, cx + r, j, x, y, k);
+            }
+        }
+        // points outside the visited rings are at least `r * cellSize` away
+        const f64 reach = r * g->cellSize;
+        if (g->heap.size() == k && g->heap.front().first <= reach * reach) {
+            break;
+        }
+    }
+
+    std::sort_heap(g->heap.begin(), g->heap.end());
+    g->matches.resize(g->heap.size());
+    for (size_t i = 0; i < g->heap.size(); ++i) {
+        g->matches[i] = g->heap[i].second;
+    }
+    *matchesLength = g->matches.size();
+    return g->matches.data();
+}
+
+
+/* ******************************************** *
+ * Hilbert
+ * ******************************************** */
+
+/**
+ * Same as `GEOSHilbertCode_r` at level 16, but for many geometries at once.
+ * Envelope centers outside the extent are clamped to the extent.
+ * Empty geometries get code 0, and are placed last by the sort.
+ *
+ * @param geoms - [in] Array<*GEOSGeometry> `n` geometries
+ * @param extent - [in/out] [xMin, yMin, xMax, yMax], computed from geometries when `xMin > xMax`
+ * @param codes - [out] Array<u32> `n` codes, may be the same memory as `geoms`
+ * @param order - [out] Array<u32> `n` geometry indices sorted by code, or nullptr
+ */
+void hilbert_codes(GEOSGeometry **geoms, u32 n, f64 *extent, u32 *codes, u32 *order) {
+    if (extent[0] > extent[2]) {
+        Envelope env;
+        for (u32 i = 0; i < n; ++i) {
+            env.expandToInclude(((Geometry *) geoms[i])->getEnvelopeInternal());
+        }
+        extent[0] = env.getMinX();
+        extent[1] = env.getMinY();
+        extent[2] = env.getMaxX();
+        extent[3] = env.getMaxY();
+    }
+
+    const f64 hside = 65535; // 2^16 - 1
+    const f64 xMin = extent[0], yMin = extent[1];
+    const f64 xScale = extent[2] > xMin ? hside / (extent[2] - xMin) : 0;
+    const f64 yScale = extent[3] > yMin ? hside / (extent[3] - yMin) : 0;
+
+    std::vector<uint64_t> keys(order ? n : 0);
+    for (u32 i = 0; i < n; ++i) {
+        const Envelope *env = ((Geometry *) geoms[i])->getEnvelopeInternal();
+        u32 code = 0;
+        if (!env->isNull()) {
+            const f64 x = std::max(0.0, std::min(hside, (env->getMinX() + env->getWidth() / 2 - xMin) * xScale));
+            const f64 y = std::max(0.0, std::min(hside, (env->getMinY() + env->getHeight() / 2 - yMin) * yScale));
+            code = geos::shape::fractal::HilbertCode::encode(16, (u32) x, (u32) y);
+        }
+        if (order) {
+            // [empty flag][code][index] - sorting keys keeps equal codes in the input order
+            keys[i] = (uint64_t) env->isNull() << 63 | (uint64_t) code << 31 | i;
+        }
+        codes[i] = code; // `geoms[i]` is no longer needed
+    }
+
+    if (order) {
+        std::sort(keys.begin(), keys.end());
+        for (u32 i = 0; i < n; ++i) {
+            order[i] = keys[i] & 0x7FFFFFFF;
+        }
+    }
+}
+
+
+/* ******************************************** *
+ * Hash
+ * ******************************************** */
+
+u32 hashMix(u32 h, u32 k) { // MurmurHash3 round
+    k *= 0xcc9e2d51;
+    k = k << 15 | k >> 17;
+    k *= 0x1b873593;
+    h ^= k;
+    h = h << 13 | h >> 19;
+    return h * 5 + 0xe6546b64;
+}
+
+u32 hashCoords(const CoordinateSequence *cs, u32 dim, u32 h) {
+    const size_t size = cs->getSize();
+    const size_t stride = cs->stride();
+    const f64 *data = cs->data();
+    h = hashMix(h, (u32) size);
+    for (size_t i = 0; i < size; ++i, data += stride) {
+        for (u32 j = 0; j < dim; ++j) {
+            const f64 v = data[j] + 0.0; // -0 -> 0
+            u32 words[2];
+            std::memcpy(words, &v, 8);
+            h = hashMix(hashMix(h, words[0]), words[1]);
+        }
+    }
+    return h;
+}
+
+u32 hashGeom(const Geometry *geom_cpp, u32 h) {
+    const GeometryTypeId type = geom_cpp->getGeometryTypeId();
+    const bool isEmpty = geom_cpp->isEmpty();
+    const bool hasZ = geom_cpp->hasZ();
+    const bool hasM = geom_cpp->hasM();
+
+    h = hashMix(h, type | isEmpty << 4 | hasZ << 5 | hasM << 6); // same as jsonify header
+
+    if (isEmpty) {
+        return h;
+    }
+
+    switch (type) {
+        case GeometryTypeId::GEOS_POINT: {
+            return hashCoords(((Point *) geom_cpp)->getCoordinatesRO(), 2 + hasZ + hasM, h);
+        }
+
+        case GeometryTypeId::GEOS_LINESTRING:
+        case GeometryTypeId::GEOS_LINEARRING:
+        case GeometryTypeId::GEOS_CIRCULARSTRING: {
+            return hashCoords(((SimpleCurve *) geom_cpp)->getCoordinatesRO(), 2 + hasZ + hasM, h);
+        }
+
+        case GeometryTypeId::GEOS_POLYGON:
+        case GeometryTypeId::GEOS_CURVEPOLYGON: {
+            const Surface *surface = (Surface *) geom_cpp;
+            const size_t interiorRingsLength = surface->getNumInteriorRing();
+            h = hashMix(h, (u32) interiorRingsLength);
+            h = hashGeom(surface->getExteriorRing(), h);
+            for (size_t i = 0; i < interiorRingsLength; ++i) {
+                h = hashGeom(surface->getInteriorRingN(i), h);
+            }
+            return h;
+        }
+
+        case GeometryTypeId::GEOS_COMPOUNDCURVE: {
+            const CompoundCurve *compoundCurve = (CompoundCurve *) geom_cpp;
+            const size_t segmentsLength = compoundCurve->getNumCurves();
+            h = hashMix(h, (u32) segmentsLength);
+            for (size_t i = 0; i < segmentsLength; ++i) {
+                h = hashGeom(compoundCurve->getCurveN(i), h);
+            }
+            return h;
+        }
+
+        default: { // multi geometries and collections
+            const size_t geometriesLength = geom_cpp->getNumGeometries();
+            h = hashMix(h, (u32) geometriesLength);
+            for (size_t i = 0; i < geometriesLength; ++i) {
+                h = hashGeom(geom_cpp->getGeometryN(i), h);
+            }
+            return h;
+        }
+    }
+}
+
+/**
+ * Computes structural hashes of the geometries, over their type, dimensions
+ * and coordinates. Geometries that are `GEOSEqualsIdentical_r` have the same hash.
+ *
+ * @param geoms - [in] Array<*GEOSGeometry> `n` geometries
+ * @param hashes - [out] Array<u32> `n` hashes, may be the same memory as `geoms`
+ */
+void hash_geoms(GEOSGeometry **geoms, u32 n, u32 *hashes) {
+    for (u32 i = 0; i < n; ++i) {
+        u32 h = hashGeom((Geometry *) geoms[i], 0);
+        h ^= h >> 16; // MurmurHash3 finalizer
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        h ^= h >> 16;
+        hashes[i] = h;
+    }
+}
+
+
+/* ******************************************** *
+ * Lifetime
+ * ******************************************** */
+
+/**
+ * Destroys many geometries and their prepared counterparts at once.
+ *
+ * @param buff - [in] Array<*GEOSGeometry> `n` geometries, nullptr when still shared,
+ * followed by Array<*GEOSPreparedGeometry> `n` prepared geometries, nullptr when not prepared
+ */
+void geoms_destroy_r(GEOSContextHandle_t ctx, u32 *buff, u32 n) {
+    GEOSGeometry **geoms = (GEOSGeometry **) buff;
+    GEOSPreparedGeometry **prepared = (GEOSPreparedGeometry **) buff + n;
+    for (u32 i = 0; i < n; ++i) {
+        if (prepared[i]) {
+            GEOSPreparedGeom_destroy_r(ctx, prepared[i]);
+        }
+        if (geoms[i]) {
+            GEOSGeom_destroy_r(ctx, geoms[i]);
+        }
+    }
+}
+
+
+/* ******************************************** *
+ * Byte size: estimated memory footprint
+ * ******************************************** */
+
+size_t coordsByteSize(const CoordinateSequence *cs) {
+    return cs->size() * cs->stride() * sizeof(f64);
+}
+
+size_t curveByteSize(const SimpleCurve *curve, size_t objectSize) {
+    return objectSize + sizeof(CoordinateSequence) + coordsByteSize(curve->getCoordinatesRO()); // sequence is owned by pointer
+}
+
+size_t geomByteSize(const Geometry *geom_cpp) {
+    switch (geom_cpp->getGeometryTypeId()) {
+        case GeometryTypeId::GEOS_POINT: {
+            return sizeof(Point) + coordsByteSize(((Point *) geom_cpp)->getCoordinatesRO()); // sequence is a member of Point
+        }
+
+        case GeometryTypeId::GEOS_LINESTRING: {
+            return curveByteSize((SimpleCurve *) geom_cpp, sizeof(LineString));
+        }
+
+        case GeometryTypeId::GEOS_LINEARRING: {
+            return curveByteSize((SimpleCurve *) geom_cpp, sizeof(LinearRing));
+        }
+
+        case GeometryTypeId::GEOS_CIRCULARSTRING: {
+            return curveByteSize((SimpleCurve *) geom_cpp, sizeof(CircularString));
+        }
+
+        case GeometryTypeId::GEOS_POLYGON:
+        case GeometryTypeId::GEOS_CURVEPOLYGON: {
+            const Surface *surface = (Surface *) geom_cpp;
+            const size_t interiorRingsLength = surface->getNumInteriorRing();
+            size_t size = geom_cpp->getGeometryTypeId() == GeometryTypeId::GEOS_POLYGON ? sizeof(Polygon) : sizeof(CurvePolygon);
+            size += interiorRingsLength * sizeof(void *); // holes vector
+            size += geomByteSize(surface->getExteriorRing());
+            for (size_t i = 0; i < interiorRingsLength; ++i) {
+                size += geomByteSize(surface->getInteriorRingN(i));
+            }
+            return size;
+        }
+
+        case GeometryTypeId::GEOS_COMPOUNDCURVE: {
+            const CompoundCurve *compoundCurve = (CompoundCurve *) geom_cpp;
+            const size_t segmentsLength = compoundCurve->getNumCurves();
+            size_t size = sizeof(CompoundCurve) + segmentsLength * sizeof(void *);
+            for (size_t i = 0; i < segmentsLength; ++i) {
+                size += geomByteSize(compoundCurve->getCurveN(i));
+            }
+            return size;
+        }
+
+        default: { // multi geometries and collections, none of them adds members to GeometryCollection
+            const size_t geometriesLength = geom_cpp->getNumGeometries();
+            size_t size = sizeof(GeometryCollection) + geometriesLength * sizeof(void *);
+            for (size_t i = 0; i < geometriesLength; ++i) {
+                size += geomByteSize(geom_cpp->getGeometryN(i));
+            }
+            return size;
+        }
+    }
+}
+
+/**
+ * Estimates memory footprint of the geometries: geometry objects, their
+ * coordinate sequences and child pointer arrays, without allocator overhead
+ * and unused vector capacity.
+ *
+ * @param geoms - [in] Array<*GEOSGeometry> `n` geometries
+ * @param sizes - [out] Array<f64> `n` sizes in bytes
+ */
+void geoms_byte_size(GEOSGeometry **geoms, u32 n, f64 *sizes) {
+    for (u32 i = 0; i < n; ++i) {
+        sizes[i] = geomByteSize((Geometry *) geoms[i]);
+    }
+}
+
+
+/* ******************************************** *
+ * Predicates: one geometry against many
+ * ******************************************** */
+
+typedef char (*Predicate_r)(GEOSContextHandle_t, const GEOSGeometry *, const GEOSGeometry *);
+typedef char (*PreparedPredicate_r)(GEOSContextHandle_t, const GEOSPreparedGeometry *, const GEOSGeometry *);
+
+enum PredicateOp : u32 {
+    PREDICATE_INTERSECTS,
+    PREDICATE_DISJOINT,
+    PREDICATE_CONTAINS,
+    PREDICATE_CONTAINS_PROPERLY,
+    PREDICATE_WITHIN,
+    PREDICATE_COVERS,
+    PREDICATE_COVERED_BY,
+    PREDICATE_CROSSES,
+    PREDICATE_OVERLAPS,
+    PREDICATE_TOUCHES,
+    PREDICATE_EQUALS,
+    PREDICATE_RELATE_PATTERN,
+};
+
+const Predicate_r predicates[] = {
+    GEOSIntersects_r,
+    GEOSDisjoint_r,
+    GEOSContains_r,
+    nullptr, // containsProperly exists only as prepared predicate
+    GEOSWithin_r,
+    GEOSCovers_r,
+    GEOSCoveredBy_r,
+    GEOSCrosses_r,
+    GEOSOverlaps_r,
+    GEOSTouches_r,
+    GEOSEquals_r,
+    nullptr, // relatePattern has a different signature
+};
+
+const PreparedPredicate_r preparedPredicates[] = {
+    GEOSPreparedIntersects_r,
+    GEOSPreparedDisjoint_r,
+    GEOSPreparedContains_r,
+    GEOSPreparedContainsProperly_r,
+    GEOSPreparedWithin_r,
+    GEOSPreparedCovers_r,
+    GEOSPreparedCoveredBy_r,
+    GEOSPreparedCrosses_r,
+    GEOSPreparedOverlaps_r,
+    GEOSPreparedTouches_r,
+    nullptr, // there is no prepared equals
+    nullptr, // relatePattern has a different signature
+};
+
+/**
+ * Evaluates predicate `op` between `a` and each of `bs`.
+ *
+ * @param pa - prepared `a`, or nullptr to use the regular predicate
+ * @param pattern - DE-9IM pattern, used only by `PREDICATE_RELATE_PATTERN`
+ * @param out - [out] Array<u8> `n` results, may be the same memory as `bs`
+ */
+void predicates_many_r(GEOSContextHandle_t ctx, u32 op, const GEOSGeometry *a, const GEOSPreparedGeometry *pa,
+                       GEOSGeometry **bs, u32 n, const char *pattern, uint8_t *out) {
+    // `out[i]` never overlaps `bs[j]` for j > i, so results can be written in place
+    if (op == PREDICATE_RELATE_PATTERN) {
+        for (u32 i = 0; i < n; ++i) {
+            out[i] = pa
+                ? GEOSPreparedRelatePattern_r(ctx, pa, bs[i], pattern)
+                : GEOSRelatePattern_r(ctx, a, bs[i], pattern);
+        }
+    } else if (pa && preparedPredicates[op]) {
+        const PreparedPredicate_r predicate = preparedPredicates[op];
+        for (u32 i = 0; i < n; ++i) {
+            out[i] = predicate(ctx, pa, bs[i]);
+        }
+    } else {
+        const Predicate_r predicate = predicates[op];
+        for (u32 i = 0; i < n; ++i) {
+            out[i] = predicate(ctx, a, bs[i]);
+        }
+    }
+}
+
+
+/* ******************************************** *
+ * Predicates: prepared geometry against many XY points
+ * ******************************************** */
+
+typedef char (*PreparedPredicateXY_r)(GEOSContextHandle_t, const GEOSPreparedGeometry *, f64, f64);
+
+/**
+ * Evaluates `GEOSPreparedContainsXY_r` (op 0) or `GEOSPreparedIntersectsXY_r` (op 1)
+ * for each point, without creating any point geometry.
+ *
+ * @param xy - [in] Array<f64> `n` points as [x, y, x, y, ...]
+ * @param out - [out] Array<u8> `n` results, may be the same memory as `xy`
+ */
+void predicates_xy_many_r(GEOSContextHandle_t ctx, u32 op, const GEOSPreparedGeometry *pa, const f64 *xy, u32 n, uint8_t *out) {
+    const PreparedPredicateXY_r predicate = op ? GEOSPreparedIntersectsXY_r : GEOSPreparedContainsXY_r;
+    for (u32 i = 0; i < n; ++i) {
+        out[i] = predicate(ctx, pa, xy[i * 2], xy[i * 2 + 1]); // `out[i]` is before `xy[i * 2]`
+    }
+}
+
+
+/* ******************************************** *
+ * Pairwise: element-wise operations on aligned arrays
+ * ******************************************** */
+
+char capturedErrorMessage[1024]; // first error message of the last error capture, truncated like GEOS messages
+
+/**
+ * Error capture replaces context error handler (which throws JS exception),
+ * so that errors can be handled per element instead of aborting the whole
+ * batch.
+ * The state is static and the handler is restored by an explicit
+ * `error_capture_end_r` call from JS, in `finally`, not by a destructor:
+ * JS exceptions unwinding through Wasm frames do not run destructors.
+ */
+struct ErrorCaptureState {
+    GEOSMessageHandler_r previous;
+    bool captured;
+};
+
+ErrorCaptureState errorCapture = {nullptr, false};
+
+void captureError(const char *message, void *) {
+    if (!errorCapture.captured) {
+        errorCapture.captured = true;
+        strncpy(capturedErrorMessage, message, sizeof(capturedErrorMessage) - 1);
+    }
+}
+
+void errorCaptureBegin(GEOSContextHandle_t ctx) {
+    capturedErrorMessage[0] = 0;
+    errorCapture.captured = false;
+    const GEOSMessageHandler_r previous = GEOSContext_setErrorMessageHandler_r(ctx, captureError, nullptr);
+    if (previous != captureError) { // otherwise the last capture was not ended, keep its `previous`
+        errorCapture.previous = previous;
+    }
+}
+
+/**
+ * Restores the error handler replaced by the last error capture.
+ */
+void error_capture_end_r(GEOSContextHandle_t ctx) {
+    if (errorCapture.previous) {
+        GEOSContext_setErrorMessageHandler_r(ctx, errorCapture.previous, nullptr);
+    }
+}
+
+const char *captured_error_message() {
+    return capturedErrorMessage;
+}
+
+enum PairwiseOp : u32 {
+    // results: Array<[*GEOSGeometry, GEOSGeomTypes]>, type is written so that JS does not have to ask for it
+    PAIRWISE_INTERSECTION,
+    PAIRWISE_DIFFERENCE,
+    PAIRWISE_SYM_DIFFERENCE,
+    PAIRWISE_UNION,
+    PAIRWISE_BUFFER, // unary, `bs` are ignored
+    // results: Array<f64>
+    PAIRWISE_DISTANCE,
+    // results: Array<u8>
+    PAIRWISE_DISTANCE_WITHIN,
+    PAIRWISE_RELATE_PATTERN,
+    // unary, results: Array<f64>, `bs` are ignored
+    PAIRWISE_AREA,
+    PAIRWISE_LENGTH,
+    PAIRWISE_BOUNDS, // 4 values per geometry: xMin, yMin, xMax, yMax
+    // results: Array<u8>, 9 per pair
+    PAIRWISE_RELATE, // DE-9IM matrix chars, without the terminating null
+};
+
+typedef GEOSGeometry *(*Overlay_r)(GEOSContextHandle_t, const GEOSGeometry *, const GEOSGeometry *);
+typedef GEOSGeometry *(*OverlayPrec_r)(GEOSContextHandle_t, const GEOSGeometry *, const GEOSGeometry *, f64);
+
+/** Writes `[*GEOSGeometry, GEOSGeomTypes]` pair, `[0, 0]` when `geom` is nullptr */
+inline bool writeGeomResult(u32 *out, u32 i, GEOSGeometry *geom) {
+    out[i * 2] = (uptr) geom;
+    out[i * 2 + 1] = geom ? ((Geometry *) geom)->getGeometryTypeId() : 0;
+    return geom;
+}
+
+/**
+ * Evaluates `op` for each pair `(as[i * aStep], bs[i * bStep])`, step 0
+ * broadcasts a single geometry against the other array.
+ *
+ * @param pa - prepared `as[0]`, used when `aStep` is 0 and `op` has a prepared version, or nullptr
+ * @param param - gridSize for overlay ops (NaN when not set), distance for
+ * buffer, maxDistance for distanceWithin
+ * @param ptrParam - GEOSBufferParams for buffer, pattern for relatePattern
+ * @param out - [out] `n` results, type depends on `op`, 0/NaN for failed elements,
+ * NaN for empty inputs of measurement ops
+ * @param errors - [out] Array<u8> `n` error flags, 1 when GEOS failed on the element
+ * @return the number of failed elements, see `captured_error_message` for the first error
+ */
+u32 pairwise_r(GEOSContextHandle_t ctx, u32 op, GEOSGeometry **as, u32 aStep, GEOSGeometry **bs, u32 bStep, u32 n,
+               const GEOSPreparedGeometry *pa, f64 param, const void *ptrParam, void *out, uint8_t *errors) {
+    errorCaptureBegin(ctx); // ended by `error_capture_end_r` call from JS
+    if (aStep) pa = nullptr;
+    u32 failed = 0;
+
+    switch (op) {
+        case PAIRWISE_INTERSECTION:
+        case PAIRWISE_DIFFERENCE:
+        case PAIRWISE_SYM_DIFFERENCE:
+        case PAIRWISE_UNION: {
+            const Overlay_r overlay[] = {GEOSIntersection_r, GEOSDifference_r, GEOSSymDifference_r, GEOSUnion_r};
+            const OverlayPrec_r overlayPrec[] = {GEOSIntersectionPrec_r, GEOSDifferencePrec_r, GEOSSymDifferencePrec_r, GEOSUnionPrec_r};
+            const bool prec = !std::isnan(param);
+            u32 *results = (u32 *) out;
+            for (u32 i = 0; i < n; ++i) {
+                const GEOSGeometry *a = as[i * aStep], *b = bs[i * bStep];
+                GEOSGeometry *result = prec ? overlayPrec[op](ctx, a, b, param) : overlay[op](ctx, a, b);
+                failed += errors[i] = !writeGeomResult(results, i, result);
+            }
+            break;
+        }
+
+        case PAIRWISE_BUFFER: {
+            const GEOSBufferParams *params = (const GEOSBufferParams *) ptrParam;
+            u32 *results = (u32 *) out;
+            for (u32 i = 0; i < n; ++i) {
+                GEOSGeometry *result = GEOSBufferWithParams_r(ctx, as[i * aStep], params, param);
+                failed += errors[i] = !writeGeomResult(results, i, result);
+            }
+            break;
+        }
+
+        case PAIRWISE_DISTANCE: {
+            f64 *results = (f64 *) out;
+            for (u32 i = 0; i < n; ++i) {
+                const GEOSGeometry *a = as[i * aStep], *b = bs[i * bStep];
+                if (((Geometry *) a)->isEmpty() || ((Geometry *) b)->isEmpty()) {
+                    results[i] = geos::DoubleNotANumber;
+                    errors[i] = 0;
+                    continue;
+                }
+                const int ok = pa
+                    ? GEOSPreparedDistance_r(ctx, pa, b, &results[i])
+                    : GEOSDistance_r(ctx, a, b, &results[i]);
+                if (!ok) results[i] = geos::DoubleNotANumber;
+                failed += errors[i] = !ok;
+            }
+            break;
+        }
+
+        case PAIRWISE_DISTANCE_WITHIN:
+        case PAIRWISE_RELATE_PATTERN: {
+            const char *pattern = (const char *) ptrParam;
+            uint8_t *results = (uint8_t *) out;
+            for (u32 i = 0; i < n; ++i) {
+                const GEOSGeometry *a = as[i * aStep], *b = bs[i * bStep];
+                char r;
+                if (op == PAIRWISE_DISTANCE_WITHIN) {
+                    r = pa ? GEOSPreparedDistanceWithin_r(ctx, pa, b, param) : GEOSDistanceWithin_r(ctx, a, b, param);
+                } else {
+                    r = pa ? GEOSPreparedRelatePattern_r(ctx, pa, b, pattern) : GEOSRelatePattern_r(ctx, a, b, pattern);
+                }
+                results[i] = r == 1;
+                failed += errors[i] = r == 2;
+            }
+            break;
+        }
+
+        case PAIRWISE_AREA:
+        case PAIRWISE_LENGTH: {
+            f64 *results = (f64 *) out;
+            for (u32 i = 0; i < n; ++i) {
+                const GEOSGeometry *a = as[i * aStep];
+                if (((Geometry *) a)->isEmpty()) {
+                    results[i] = geos::DoubleNotANumber;
+                    errors[i] = 0;
+                    continue;
+                }
+                const int ok = op == PAIRWISE_AREA
+                    ? GEOSArea_r(ctx, a, &results[i])
+                    : GEOSLength_r(ctx, a, &results[i]);
+                if (!ok) results[i] = geos::DoubleNotANumber;
+                failed += errors[i] = !ok;
+            }
+            break;
+        }
+
+        case PAIRWISE_BOUNDS: {
+            f64 *results = (f64 *) out;
+            for (u32 i = 0; i < n; ++i) {
+                writeEnvelope((Geometry *) as[i * aStep], results + i * 4);
+                errors[i] = 0;
+            }
+            break;
+        }
+
+        case PAIRWISE_RELATE: {
+            uint8_t *results = (uint8_t *) out;
+            for (u32 i = 0; i < n; ++i, results += 9) {
+                const GEOSGeometry *a = as[i * aStep], *b = bs[i * bStep];
+                char *matrix = pa ? GEOSPreparedRelate_r(ctx, pa, b) : GEOSRelate_r(ctx, a, b);
+                if (matrix) {
+                    memcpy(results, matrix, 9);
+                    GEOSFree_r(ctx, matrix);
+                } else {
+                    memset(results, 0, 9);
+                }
+                failed += errors[i] = !matrix;
+            }
+            break;
+        }
+    }
+
+    return failed;
+}
+
+
+/* ******************************************** *
+ * Distance matrix
+ * ******************************************** */
+
+/**
+ * Computes distances between each of `as` and each of `bs`.
+ *
+ * When `prepared`, geometries of the side with more vertices in total are
+ * prepared, so that their indexes are reused for every geometry of the
+ * other side.
+ *
+ * @param maxDistance - distances greater than this are not computed, or Infinity
+ * @param out - [out] Array<f64> `na * nb` distances, row-major - `out[i * nb + j]`
+ * is the distance between `as[i]` and `bs[j]`; Infinity for pairs beyond
+ * `maxDistance`, NaN for empty inputs and failed pairs
+ * @return the number of failed pairs, see `captured_error_message` for the first error
+ */
+u32 distance_matrix_r(GEOSContextHandle_t ctx, GEOSGeometry **as, u32 na, GEOSGeometry **bs, u32 nb,
+                      f64 maxDistance, u32 prepared, f64 *out) {
+    errorCaptureBegin(ctx); // ended by `error_capture_end_r` call from JS
+
+    bool prepareB = false;
+    std::vector<const GEOSPreparedGeometry *> pgs;
+    if (prepared && na && nb) {
+        size_t aPoints = 0, bPoints = 0;
+        for (u32 i = 0; i < na; ++i) aPoints += ((Geometry *) as[i])->getNumPoints();
+        for (u32 j = 0; j < nb; ++j) bPoints += ((Geometry *) bs[j])->getNumPoints();
+        prepareB = bPoints > aPoints;
+        GEOSGeometry **geoms = prepareB ? bs : as;
+        const u32 n = prepareB ? nb : na;
+        pgs.reserve(n);
+        for (u32 i = 0; i < n; ++i) {
+            pgs.push_back(GEOSPrepare_r(ctx, geoms[i]));
+        }
+    }
+
+    const bool cutoff = std::isfinite(maxDistance);
+    u32 failed = 0;
+    for (u32 i = 0; i < na; ++i) {
+        const GEOSGeometry *a = as[i];
+        const bool aEmpty = ((Geometry *) a)->isEmpty();
+        for (u32 j = 0; j < nb; ++j) {
+            const GEOSGeometry *b = bs[j];
+            f64 &d = out[i * nb + j];
+            if (aEmpty || ((Geometry *) b)->isEmpty()) {
+                d = geos::DoubleNotANumber;
+                continue;
+            }
+            const GEOSPreparedGeometry *pg = pgs.empty() ? nullptr : (prepareB ? pgs[j] : pgs[i]);
+            const GEOSGeometry *other = prepareB ? a : b;
+            if (cutoff) {
+                const char within = pg
+                    ? GEOSPreparedDistanceWithin_r(ctx, pg, other, maxDistance)
+                    : GEOSDistanceWithin_r(ctx, a, b, maxDistance);
+                if (within != 1) {
+                    d = within ? geos::DoubleNotANumber : geos::DoubleInfinity;
+                    failed += within == 2;
+                    continue;
+                }
+            }
+            const int ok = pg
+                ? GEOSPreparedDistance_r(ctx, pg, other, &d)
+                : GEOSDistance_r(ctx, a, b, &d);
+            if (!ok) {
+                d = geos::DoubleNotANumber;
+                failed++;
+            }
+        }
+    }
+
+    for (const GEOSPreparedGeometry *pg : pgs) {
+        GEOSPreparedGeom_destroy_r(ctx, pg);
     }
-    return nullptr;
+    return failed;
 }
 }
 
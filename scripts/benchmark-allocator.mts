@@ -0,0 +1,86 @@
+import { resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import type { Geometry as GeoJSON_Geometry } from 'geojson';
+import { beginArena, freeAll, fromGeoJSON, initialize, resetArena, terminate, toGeoJSON, unaryUnion } from '../src/index.mjs';
+import { geos } from '../src/core/geos.mjs';
+
+
+/**
+ * Compares Wasm builds with different allocators (see `cpp/INSTALL.md`)
+ * on a "geosify, union, serialize, free" workload.
+ *
+ * Usage:
+ *   npm run benchmark-allocator -- <path to .wasm> [<path to another .wasm> ...] [--rounds=N] [--polygons=N]
+ *
+ * Every build runs the rounds freeing the geometries with `freeAll`, builds
+ * with arena support run them again inside `beginArena`/`resetArena`, so
+ * both modes are compared on the same build.
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPaths = args.filter(arg => !arg.startsWith('--'));
+    const option = (name: string, defaultValue: number) => {
+        const arg = args.find(arg => arg.startsWith(`--${name}=`));
+        return arg ? Number(arg.slice(name.length + 3)) : defaultValue;
+    };
+    const rounds = option('rounds', 50);
+    const polygonCount = option('polygons', 2000);
+
+    if (!wasmPaths.length) {
+        console.error('Usage: benchmark-allocator <path to .wasm> [...] [--rounds=N] [--polygons=N]');
+        process.exit(1);
+    }
+
+    // deterministic input, the same for every build
+    let seed = 1;
+    const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647;
+    const input: GeoJSON_Geometry = {
+        type: 'GeometryCollection',
+        geometries: Array.from({ length: polygonCount }, () => {
+            const x = random() * 1000, y = random() * 1000, r = 1 + random() * 10;
+            const ring = Array.from({ length: 33 }, (_, i) => {
+                const a = (i % 32) / 32 * Math.PI * 2;
+                return [ x + Math.cos(a) * r, y + Math.sin(a) * r ];
+            });
+            return { type: 'Polygon', coordinates: [ ring ] };
+        }),
+    };
+
+    const round = () => {
+        const collection = fromGeoJSON(input);
+        const union = unaryUnion(collection);
+        toGeoJSON(union);
+        return [ collection, union ];
+    };
+
+    console.log(`rounds: ${rounds}, polygons: ${polygonCount}`);
+    console.log('build                          | mode    | total ms | ms/round | memory MB');
+
+    for (const wasmPath of wasmPaths) {
+        const module = await WebAssembly.compile(readFileSync(resolve(wasmPath)));
+        await initialize(module);
+        const modes = geos.arena_begin ? [ 'freeAll', 'arena' ] as const : [ 'freeAll' ] as const;
+
+        // warm up, also lets the memory grow before measuring
+        freeAll(round());
+        globalThis.gc?.();
+
+        for (const mode of modes) {
+            const t0 = performance.now();
+            for (let i = 0; i < rounds; i++) {
+                if (mode === 'arena') {
+                    beginArena({ capacity: 256 * 1024 * 1024 });
+                    round();
+                    resetArena();
+                } else {
+                    freeAll(round());
+                }
+            }
+            const total = performance.now() - t0;
+            const memory = geos.memory.buffer.byteLength / 1024 / 1024;
+
+            console.log(`${wasmPath.slice(-30).padEnd(30)} | ${mode.padEnd(7)} | ${total.toFixed(0).padStart(8)} | ${(total / rounds).toFixed(2).padStart(8)} | ${memory.toFixed(0).padStart(9)}`);
+        }
+        terminate();
+    }
+}();
@@ -0,0 +1,55 @@
+import { resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import { area, fromWKT, initialize, terminate } from '../src/index.mjs';
+
+
+/**
+ * Measures time-to-first-operation of Wasm builds, for example with and
+ * without `GEOS_JS_EVAL_CTORS` (see `cpp/INSTALL.md`):
+ * compilation, instantiation (`_initialize` included) and the first call.
+ *
+ * Usage:
+ *   npm run benchmark-cold-start -- <path to .wasm> [<path to another .wasm> ...] [--rounds=N]
+ *
+ * V8 caches compiled code per process, only the first compilation of each
+ * build is cold; the instantiation and the first call are cold in every round.
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPaths = args.filter(arg => !arg.startsWith('--'));
+    const roundsArg = args.find(arg => arg.startsWith('--rounds='));
+    const rounds = roundsArg ? Number(roundsArg.slice(9)) : 50;
+
+    if (!wasmPaths.length) {
+        console.error('Usage: benchmark-cold-start <path to .wasm> [...] [--rounds=N]');
+        process.exit(1);
+    }
+
+    const median = (values: number[]) => values.sort((a, b) => a - b)[ values.length >> 1 ];
+
+    console.log(`rounds: ${rounds}, median times in ms`);
+    console.log('build                          |  compile | instantiate | first op |    total');
+
+    for (const wasmPath of wasmPaths) {
+        const wasmData = readFileSync(resolve(wasmPath));
+        const compileTimes: number[] = [], instantiateTimes: number[] = [], firstOpTimes: number[] = [];
+
+        for (let i = 0; i < rounds; i++) {
+            const t0 = performance.now();
+            const module = await WebAssembly.compile(wasmData);
+            const t1 = performance.now();
+            await initialize(module);
+            const t2 = performance.now();
+            area(fromWKT('POLYGON ((0 0, 1 0, 0 1, 0 0))'));
+            const t3 = performance.now();
+            terminate();
+
+            compileTimes.push(t1 - t0);
+            instantiateTimes.push(t2 - t1);
+            firstOpTimes.push(t3 - t2);
+        }
+
+        const compile = median(compileTimes), instantiate = median(instantiateTimes), firstOp = median(firstOpTimes);
+        console.log(`${wasmPath.slice(-30).padEnd(30)} | ${compile.toFixed(2).padStart(8)} | ${instantiate.toFixed(2).padStart(11)} | ${firstOp.toFixed(2).padStart(8)} | ${(compile + instantiate + firstOp).toFixed(2).padStart(8)}`);
+    }
+}();
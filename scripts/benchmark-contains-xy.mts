@@ -0,0 +1,67 @@
+import { join, resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import { buffer, contains, containsMany, containsXY, freeAll, initialize, point, prepare } from '../src/index.mjs';
+
+
+/**
+ * Compares ways of classifying raw points against a prepared polygon:
+ * `point()` + `contains` loop, `point()` + `containsMany` and `containsXY`.
+ * Times include creating and freeing the point geometries.
+ *
+ * Usage:
+ *   npm run benchmark-contains-xy -- [<path to .wasm>] [--points=N] [--rounds=N]
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPath = args.find(arg => !arg.startsWith('--')) ?? join(import.meta.dirname, '../cpp/build/js/geos_js.wasm');
+    const option = (name: string, defaultValue: number) => {
+        const arg = args.find(arg => arg.startsWith(`--${name}=`));
+        return arg ? Number(arg.slice(name.length + 3)) : defaultValue;
+    };
+    const pointCount = option('points', 100_000);
+    const rounds = option('rounds', 10);
+
+    await initialize(await WebAssembly.compile(readFileSync(resolve(wasmPath))));
+
+    // deterministic input, a ~1000 vertices polygon and points around it
+    let seed = 1;
+    const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647;
+    const zone = prepare(buffer(point([ 0, 0 ]), 100, { quadrantSegments: 250 }));
+    const coords = new Float64Array(pointCount * 2);
+    for (let i = 0; i < coords.length; i++) {
+        coords[ i ] = (random() - 0.5) * 250;
+    }
+
+    const variants: [ string, () => number ][] = [
+        [ 'point + contains', () => {
+            let inside = 0;
+            for (let i = 0; i < coords.length; i += 2) {
+                const p = point([ coords[ i ], coords[ i + 1 ] ]);
+                inside += +contains(zone, p);
+                p.free();
+            }
+            return inside;
+        } ],
+        [ 'point + containsMany', () => {
+            const points = Array.from({ length: pointCount }, (_, i) => point([ coords[ i * 2 ], coords[ i * 2 + 1 ] ]));
+            const inside = containsMany(zone, points).reduce((sum, v) => sum + v, 0);
+            freeAll(points);
+            return inside;
+        } ],
+        [ 'containsXY', () => containsXY(zone, coords).reduce((sum, v) => sum + v, 0) ],
+    ];
+
+    console.log(`points: ${pointCount}, rounds: ${rounds}`);
+    console.log('variant              | ms/round | inside');
+
+    for (const [ name, fn ] of variants) {
+        fn(); // warm up
+        let inside = 0;
+        const t0 = performance.now();
+        for (let i = 0; i < rounds; i++) {
+            inside = fn();
+        }
+        const t = (performance.now() - t0) / rounds;
+        console.log(`${name.padEnd(20)} | ${t.toFixed(1).padStart(8)} | ${inside}`);
+    }
+}();
@@ -0,0 +1,78 @@
+import { join, resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import { fromGeoJSON, heapStats, initialize, terminate } from '../src/index.mjs';
+import { geos } from '../src/core/geos.mjs';
+
+
+/**
+ * Compares `fromGeoJSON` with and without `dedup` on a collection where
+ * every geometry is repeated `--copies` times: import time and the Wasm
+ * memory kept by the imported geometries.
+ *
+ * Usage:
+ *   npm run benchmark-dedup -- [<path to .wasm>] [--polygons=N] [--copies=N] [--vertices=N] [--rounds=N]
+ *
+ * Every mode runs on a fresh instance, so the `WebAssembly.Memory` size
+ * (which never shrinks) is comparable. Heap stats are reported only by
+ * builds with `GEOS_JS_MALLOC_HOOKS=ON`.
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPath = args.find(arg => !arg.startsWith('--')) ?? join(import.meta.dirname, '../cpp/build/js/geos_js.wasm');
+    const option = (name: string, defaultValue: number) => {
+        const arg = args.find(arg => arg.startsWith(`--${name}=`));
+        return arg ? Number(arg.slice(name.length + 3)) : defaultValue;
+    };
+    const polygonCount = option('polygons', 1000);
+    const copies = option('copies', 10);
+    const vertexCount = option('vertices', 100);
+    const rounds = option('rounds', 5);
+
+    // e.g. administrative boundaries repeated in every feature of a join result
+    const polygons = Array.from({ length: polygonCount }, (_, i) => ({
+        type: 'Polygon' as const,
+        coordinates: [ Array.from({ length: vertexCount + 1 }, (_, j) => {
+            const a = j % vertexCount / vertexCount * 2 * Math.PI;
+            return [ i * 10 + Math.cos(a), Math.sin(a) ];
+        }) ],
+    }));
+    const collection = {
+        type: 'FeatureCollection' as const,
+        features: Array.from({ length: polygonCount * copies }, (_, i) => ({
+            type: 'Feature' as const,
+            id: i,
+            properties: null,
+            geometry: polygons[ i % polygonCount ],
+        })),
+    };
+
+    const module = await WebAssembly.compile(readFileSync(resolve(wasmPath)));
+
+    console.log(`${polygonCount} polygons of ${vertexCount} vertices, ${copies} copies each, ${rounds} rounds`);
+    console.log('mode     | import ms | memory MB | in use MB | allocations');
+
+    for (const dedup of [ false, true ]) {
+        await initialize(module);
+        const hasHeapStats = Boolean(geos.heap_stats);
+
+        let best = Infinity;
+        for (let round = 0; round < rounds; round++) {
+            const t0 = performance.now();
+            const geometries = fromGeoJSON(collection, { dedup });
+            best = Math.min(best, performance.now() - t0);
+            if (round < rounds - 1) {
+                for (const geometry of geometries) {
+                    geometry.free();
+                }
+            }
+        }
+        // the geometries of the last round are alive
+        const memory = geos.memory.buffer.byteLength / 1024 / 1024;
+        const stats = hasHeapStats ? heapStats() : undefined;
+        const inUse = stats ? (stats.inUse / 1024 / 1024).toFixed(1) : '-';
+        const allocations = stats ? String(stats.allocations) : '-';
+
+        console.log(`${(dedup ? 'dedup' : 'plain').padEnd(8)} | ${best.toFixed(1).padStart(9)} | ${memory.toFixed(0).padStart(9)} | ${inUse.padStart(9)} | ${allocations.padStart(11)}`);
+        terminate();
+    }
+}();
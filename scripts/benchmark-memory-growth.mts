@@ -0,0 +1,65 @@
+import { join, resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import { fromGeoJSON, initialize, memoryGrowthPolicy, memoryGrowthStats, type MemoryGrowthOptions, terminate } from '../src/index.mjs';
+import { geos } from '../src/core/geos.mjs';
+
+
+/**
+ * Compares memory growth policies on a large import, geometries are
+ * created in batches and kept alive until the memory reaches the target size.
+ *
+ * Usage:
+ *   npm run benchmark-memory-growth -- [<path to .wasm>] [--to=MB]
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPath = args.find(arg => !arg.startsWith('--')) ?? join(import.meta.dirname, '../cpp/build/js/geos_js.wasm');
+    const toArg = args.find(arg => arg.startsWith('--to='));
+    const targetByteLength = (toArg ? Number(toArg.slice(5)) : 2048) * 1024 * 1024;
+
+    const policies: [ string, MemoryGrowthOptions ][] = [
+        [ 'linear 16MB', {} ],
+        [ 'geometric 1.25', { factor: 1.25 } ],
+        [ 'geometric 1.5', { factor: 1.5 } ],
+        [ 'geometric 2', { factor: 2 } ],
+    ];
+
+    // ~1.6MB of coordinates per batch
+    const batch = {
+        type: 'FeatureCollection' as const,
+        features: Array.from({ length: 100 }, (_, i) => ({
+            type: 'Feature' as const,
+            properties: null,
+            geometry: {
+                type: 'LineString' as const,
+                coordinates: Array.from({ length: 1000 }, (_, j) => [ i, j ]),
+            },
+        })),
+    };
+
+    const module = await WebAssembly.compile(readFileSync(resolve(wasmPath)));
+
+    console.log(`import until ${targetByteLength / 1024 / 1024}MB`);
+    console.log('policy          | total ms | growths | growth ms | grown MB | memory MB');
+
+    for (const [ name, options ] of policies) {
+        await initialize(module);
+        memoryGrowthPolicy(options);
+
+        const kept = [];
+        const t0 = performance.now();
+        try {
+            while (geos.memory.buffer.byteLength < targetByteLength) {
+                kept.push(fromGeoJSON(batch));
+            }
+        } catch (e) {
+            console.log(`${name.padEnd(15)} | failed: ${(e as Error).message}`);
+        }
+        const total = performance.now() - t0;
+        const { count, time, bytes } = memoryGrowthStats();
+        const memory = geos.memory.buffer.byteLength / 1024 / 1024;
+
+        console.log(`${name.padEnd(15)} | ${total.toFixed(0).padStart(8)} | ${String(count).padStart(7)} | ${time.toFixed(1).padStart(9)} | ${(bytes / 1024 / 1024).toFixed(0).padStart(8)} | ${memory.toFixed(0).padStart(9)}`);
+        terminate();
+    }
+}();
@@ -0,0 +1,96 @@
+import { join, resolve } from 'node:path';
+import { readFileSync } from 'node:fs';
+import { freeAll, initialize, point, pointGridIndex, strTreeIndex } from '../src/index.mjs';
+
+
+/**
+ * Compares `pointGridIndex` with `strTreeIndex` of point geometries on
+ * uniformly distributed points: build time, bbox queries and nearest
+ * neighbour queries. The STRtree build time includes creating the points.
+ *
+ * Usage:
+ *   npm run benchmark-point-grid -- [<path to .wasm>] [--points=N] [--queries=N]
+ */
+void async function main() {
+    const args = process.argv.slice(2);
+    const wasmPath = args.find(arg => !arg.startsWith('--')) ?? join(import.meta.dirname, '../cpp/build/js/geos_js.wasm');
+    const option = (name: string, defaultValue: number) => {
+        const arg = args.find(arg => arg.startsWith(`--${name}=`));
+        return arg ? Number(arg.slice(name.length + 3)) : defaultValue;
+    };
+    const pointCount = option('points', 1_000_000);
+    const queryCount = option('queries', 100_000);
+
+    await initialize(await WebAssembly.compile(readFileSync(resolve(wasmPath))));
+
+    // deterministic input
+    let seed = 1;
+    const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647;
+    const coords = new Float64Array(pointCount * 2);
+    for (let i = 0; i < coords.length; i++) {
+        coords[ i ] = random() * 1000;
+    }
+    const queries = new Float64Array(queryCount * 2);
+    for (let i = 0; i < queries.length; i++) {
+        queries[ i ] = random() * 1000;
+    }
+    const d = 1000 / Math.sqrt(pointCount) * 2; // query box of ~16 points
+    const out = new Uint32Array(pointCount);
+
+    const time = (fn: () => number) => {
+        const t0 = performance.now();
+        const found = fn();
+        return [ performance.now() - t0, found ];
+    };
+
+    console.log(`points: ${pointCount}, queries: ${queryCount}`);
+    console.log('index      | build ms | bbox ms | bbox found | nearest ms');
+
+    {
+        let grid!: ReturnType<typeof pointGridIndex>;
+        const [ build ] = time(() => (grid = pointGridIndex(coords), 0));
+        const [ bbox, found ] = time(() => {
+            let found = 0;
+            for (let i = 0; i < queries.length; i += 2) {
+                found += grid.queryBBox(queries[ i ], queries[ i + 1 ], queries[ i ] + d, queries[ i + 1 ] + d, out);
+            }
+            return found;
+        });
+        const [ nearest ] = time(() => {
+            for (let i = 0; i < queries.length; i += 2) {
+                grid.nearest(queries[ i ], queries[ i + 1 ], 1, out);
+            }
+            return 0;
+        });
+        grid.free();
+        console.log(`point grid | ${build.toFixed(0).padStart(8)} | ${bbox.toFixed(0).padStart(7)} | ${String(found).padStart(10)} | ${nearest.toFixed(0).padStart(10)}`);
+    }
+
+    {
+        let tree!: ReturnType<typeof strTreeIndex>;
+        let points!: ReturnType<typeof point>[];
+        const [ build ] = time(() => {
+            points = Array.from({ length: pointCount }, (_, i) => point([ coords[ i * 2 ], coords[ i * 2 + 1 ] ]));
+            tree = strTreeIndex(points);
+            return 0;
+        });
+        const [ bbox, found ] = time(() => {
+            let found = 0;
+            for (let i = 0; i < queries.length; i += 2) {
+                found += tree.queryBBoxIndices(queries[ i ], queries[ i + 1 ], queries[ i ] + d, queries[ i + 1 ] + d, out);
+            }
+            return found;
+        });
+        const [ nearest ] = time(() => {
+            for (let i = 0; i < queries.length; i += 2) {
+                const q = point([ queries[ i ], queries[ i + 1 ] ]);
+                tree.nearestAllIndices(q, out);
+                q.free();
+            }
+            return 0;
+        });
+        tree.free();
+        freeAll(points);
+        console.log(`STRtree    | ${build.toFixed(0).padStart(8)} | ${bbox.toFixed(0).padStart(7)} | ${String(found).padStart(10)} | ${nearest.toFixed(0).padStart(10)}`);
+    }
+}();
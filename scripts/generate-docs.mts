@@ -42,7 +42,7 @@ const apiSidebar: SidebarCategory[] = [
     {
         label: 'Other',
         dir: '/other',
-        forced: new Set([ 'prepare', 'unprepare' ]),
+        forced: new Set([ 'prepare', 'unprepare', 'autoPrepare' ]),
     },
     {
         label: 'Types',
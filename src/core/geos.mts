@@ -1,11 +1,22 @@
-import type { GEOSBufferParams, GEOSMakeValidParams, GEOSMessageHandler_r, GEOSWKBReader, GEOSWKBWriter, GEOSWKTReader, GEOSWKTWriter, Ptr, WasmGEOS } from './types/WasmGEOS.mjs';
-import type { WasmOther } from './types/WasmOther.mjs';
+import type { GEOSBufferParams, GEOSContextHandle_t, GEOSGeometry, GEOSMakeValidParams, GEOSMessageHandler_r, GEOSPreparedGeometry, GEOSWKBReader, GEOSWKBWriter, GEOSWKTReader, GEOSWKTWriter, Ptr, WasmGEOS } from './types/WasmGEOS.mjs';
+import type { PointGrid, STRtree, WasmOther } from './types/WasmOther.mjs';
+import type { AutoPrepareCache } from '../geom/PreparedGeometry.mjs';
+import type { SharedGeometry } from '../geom/Geometry.mjs';
+import type { ArenaState } from '../other/arena.mjs';
+import { MemoryGrowthPolicy } from '../other/memoryGrowth.mjs';
 import { POINTER } from './symbols.mjs';
-import { ReusableBuffer, ReusableF64, ReusableU32 } from './reusable-memory.mjs';
+import { ReusableBuffer, ReusableF64, ReusableU32, ScratchBuffer } from './reusable-memory.mjs';
 import { GEOSError } from './GEOSError.mjs';
 import { initialize } from '../index.mjs';
 
 
+/**
+ * Version of the interface with the Wasm module (export signatures and
+ * buffer layouts), keep in sync with `abi_version` in geos_js.cpp
+ */
+const ABI_VERSION = 1;
+
+
 interface GEOS extends WasmGEOS, WasmOther {
 }
 
@@ -19,6 +30,10 @@ class GEOS {
     F64: Float64Array;
 
     buff: ReusableBuffer;
+    /** For requests larger than `buff` */
+    s_b: ScratchBuffer;
+
+    m_g: MemoryGrowthPolicy;
 
     u1: ReusableU32;
     u2: ReusableU32;
@@ -36,22 +51,19 @@ class GEOS {
     }
 
     buffByL(l: number): ReusableBuffer {
-        let { buff } = this;
-        if (l > buff.l) {
-            const tmpBuffPtr = this.malloc(l);
-            buff = new ReusableBuffer(tmpBuffPtr, l);
-        }
-        return buff;
+        const { buff } = this;
+        return l > buff.l ? this.s_b.acquire(l) : buff;
     }
 
     buffByL4(l4: number): ReusableBuffer {
-        let { buff } = this;
-        if (l4 > buff.l4) {
-            const tmpBuffLen = l4 * 4;
-            const tmpBuffPtr = this.malloc(tmpBuffLen);
-            buff = new ReusableBuffer(tmpBuffPtr, tmpBuffLen);
-        }
-        return buff;
+        const { buff } = this;
+        return l4 > buff.l4 ? this.s_b.acquire(l4 * 4) : buff;
+    }
+
+    /** Like `buffByL4`, but prefers the scratch buffer when it is free and large enough, for outputs of unknown size */
+    buffAtLeastL4(l4: number): ReusableBuffer {
+        const { buff, s_b } = this;
+        return !s_b.inUse && s_b.buff && s_b.buff.l4 > Math.max(l4, buff.l4) ? s_b.acquire(l4 * 4) : this.buffByL4(l4);
     }
 
 
@@ -61,17 +73,21 @@ class GEOS {
     te: TextEncoder = new TextEncoder();
 
     encodeString(str: string): ReusableBuffer {
+        const buff = this.buffByL(str.length + 1);
+        this.encodeStringAt(str, buff[ POINTER ]);
+        return buff;
+    }
+
+    /** Encodes null-terminated `str` at `ptr`, `str.length + 1` bytes have to be available */
+    encodeStringAt(str: string, ptr: Ptr<any>): void {
         const strLen = str.length;
-        const buff = this.buffByL(strLen + 1);
-        const idx = buff[ POINTER ];
-        const dst = this.U8.subarray(idx, idx + strLen + 1);
+        const dst = this.U8.subarray(ptr, ptr + strLen + 1);
         const stats = this.te.encodeInto(str, dst);
         if (stats.written !== strLen) {
             // geos related strings are expected to be simple 1 byte utf8
             throw new GEOSError('Unexpected string encoding result');
         }
         dst[ strLen ] = 0;
-        return buff;
     }
 
     decodeString(ptr: Ptr<string>): string {
@@ -109,7 +125,7 @@ class GEOS {
         const fnIdx = this.functionsInTableMap.get(fn);
         if (fnIdx) {
             this.table.set(fnIdx, null);
-            this.functionsInTableMap.delete(this.table.get(fnIdx));
+            this.functionsInTableMap.delete(fn);
             this.freeTableIndexes.push(fnIdx);
         }
     }
@@ -123,6 +139,18 @@ class GEOS {
     b_w: Record<string, Ptr<GEOSWKBWriter>> = {};
     b_p: Record<string, Ptr<GEOSBufferParams>> = {};
     m_v: Record<string, Ptr<GEOSMakeValidParams>> = {};
+    a_p?: AutoPrepareCache;
+    /** Active arena of this instance, see `beginArena` */
+    a_s?: ArenaState;
+    /** Whether a pool run is in progress on this instance, see `GEOSPool#run` */
+    p_r?: boolean;
+
+    /* finalization registries of the objects owned by this instance, created on first use by their classes */
+
+    f_g?: FinalizationRegistry<Ptr<GEOSGeometry> | SharedGeometry>;
+    f_p?: FinalizationRegistry<Ptr<GEOSPreparedGeometry>>;
+    f_t?: FinalizationRegistry<Ptr<STRtree>>;
+    f_i?: FinalizationRegistry<Ptr<PointGrid>>;
 
     onGEOSError: GEOSMessageHandler_r = (messagePtr, _userdata) => {
         const message = this.decodeString(messagePtr);
@@ -135,7 +163,9 @@ class GEOS {
         throw error;
     };
 
-    constructor(instance: WebAssembly.Instance) {
+    constructor(instance: WebAssembly.Instance, owner: ImportsOwner) {
+        owner.geos = this; // before `_initialize`, which can already grow the memory
+
         interface WasmExports extends WasmGEOS, WasmOther {
             memory: WebAssembly.Memory;
             __indirect_function_table: WebAssembly.Table;
@@ -145,11 +175,22 @@ class GEOS {
 
         this.memory = memory;
         this.updateMemory();
+        this.m_g = new MemoryGrowthPolicy({}, memory.buffer.byteLength);
 
         this.table = __indirect_function_table;
 
+        const abiVersion = exports.abi_version?.();
+        if (abiVersion !== ABI_VERSION) {
+            throw new GEOSError(`Wasm module is out of date with the JS sources (interface version ${abiVersion ?? 'unknown'}, expected ${ABI_VERSION}), rebuild it with \`make geos-js-build\``);
+        }
+
         exports._initialize();
-        const ctx = exports.GEOS_init_r();
+        this.updateMemory();
+        // GEOS context and the buffers are created by the first `runtime_state` call, in builds
+        // with `GEOS_JS_EVAL_CTORS=ON` already at build time by Wasm static initializer
+        const state = exports.runtime_state() / 4;
+        const ctx = this.U32[ state ] as Ptr<GEOSContextHandle_t>;
+        let ptr: number = this.U32[ state + 1 ];
         exports.GEOSContext_setErrorMessageHandler_r(ctx, this.addFunction(this.onGEOSError, 'vpp'), 0 as Ptr<void>);
 
         // bind ctx to all `_r` functions and remove `_r` from their name:
@@ -163,13 +204,9 @@ class GEOS {
             }
         }
 
-        const buffLen = 4096; // 4KB
-        let ptr: number = exports.malloc(
-            buffLen + // buff
-            2 * 4 + // u32s
-            4 * 8, // f64s
-        );
+        const buffLen = 4096; // 4KB, followed by 2 u32s and 4 f64s, keep in sync with `runtimeState` in geos_js.cpp
         this.buff = new ReusableBuffer(ptr, buffLen);
+        this.s_b = new ScratchBuffer(this);
         this.u1 = new ReusableU32(ptr += buffLen);
         this.u2 = new ReusableU32(ptr += 4);
         this.f1 = new ReusableF64(ptr += 4);
@@ -221,24 +258,25 @@ const uleb128Encode = (n: number, target: number[]): void => {
 };
 
 
-const imports = {
+/** The instance the imports belong to, not the global `geos`, which could be another instance */
+interface ImportsOwner {
+    geos?: GEOS;
+}
+
+const createImports = (owner: ImportsOwner) => ({
     env: {
         emscripten_notify_memory_growth() {
-            // memory growth linear step:
-            const growStep = 256; // 256 * 64KB = 16MB
-            const currentPageCount = geos.memory.buffer.byteLength / 65536;
-            const pagesToGrow = growStep - (currentPageCount % growStep);
-            geos.memory.grow(pagesToGrow);
-            geos.updateMemory();
+            const instance = owner.geos!;
+            instance.m_g.onGrowth(instance);
         },
     },
     wasi_snapshot_preview1: {
         random_get(buffer: number, size: number) {
-            crypto.getRandomValues(geos.U8.subarray(buffer >>>= 0, buffer + size >>> 0));
+            crypto.getRandomValues(owner.geos!.U8.subarray(buffer >>>= 0, buffer + size >>> 0));
             return 0;
         },
     },
-};
+});
 
 
 const geosPlaceholder = new Proxy({} as GEOS, {
@@ -257,20 +295,48 @@ export let geos: GEOS = geosPlaceholder;
 export async function instantiate(source: Response | Promise<Response> | WebAssembly.Module): Promise<WebAssembly.Module> {
     let module: WebAssembly.Module;
     let instance: WebAssembly.Instance;
+    const owner: ImportsOwner = {};
+    const imports = createImports(owner);
     if (source instanceof WebAssembly.Module) {
         module = source;
         instance = await WebAssembly.instantiate(source, imports);
     } else {
         ({ module, instance } = await WebAssembly.instantiateStreaming(source, imports));
     }
-    geos = new GEOS(instance);
+    geos = new GEOS(instance, owner);
     return module;
 }
 
 
+/**
+ * Creates a GEOS instance from an already compiled module without making
+ * it the active one.
+ * @internal
+ */
+export async function instantiateDetached(module: WebAssembly.Module): Promise<GEOS> {
+    const owner: ImportsOwner = {};
+    return new GEOS(await WebAssembly.instantiate(module, createImports(owner)), owner);
+}
+
+
+/**
+ * Makes `instance` the active one, all the functions operate on the active
+ * instance. Returns the previously active instance, to be restored.
+ * @internal
+ */
+export function activate(instance: GEOS): GEOS {
+    const previous = geos;
+    geos = instance;
+    return previous;
+}
+
+
 /**
  * Terminates the initialized `geos.js` module and releases associated resources.
  *
+ * Geometries and spatial indexes created before the termination keep
+ * the memory of the terminated module until they are garbage collected.
+ *
  * @returns A Promise that resolves when the termination is complete
  *
  * @see {@link initializeFromBase64}
@@ -0,0 +1,200 @@
+import type { GEOSGeometry, GEOSPreparedGeometry, Ptr } from './types/WasmGEOS.mjs';
+import { type Geometry, GeometryRef, GEOSGeometryTypeDecoder } from '../geom/Geometry.mjs';
+import { P_POINTER, POINTER } from './symbols.mjs';
+import { GEOSError } from './GEOSError.mjs';
+import { geos } from './geos.mjs';
+
+
+export interface BatchOptions {
+
+    /**
+     * Array to report failed elements in.
+     *
+     * By default, the first element on which GEOS fails makes the whole
+     * batch throw. When this array is provided, failures do not throw,
+     * instead `errors[ i ]` is set to `1` for each failed element (and to
+     * `0` otherwise), and the result of the failed element is `null`, `NaN`
+     * or `0`, depending on the result type.\
+     * The array has to be at least as long as the batch.
+     */
+    errors?: Uint8Array;
+
+}
+
+
+/** Pairwise op codes, must match `PairwiseOp` enum in `geos_js.cpp` */
+const PairwiseOpIdMap = {
+    intersection: 0,
+    difference: 1,
+    symmetricDifference: 2,
+    union: 3,
+    buffer: 4,
+    distance: 5,
+    distanceWithin: 6,
+    relatePattern: 7,
+    area: 8,
+    length: 9,
+    bounds: 10,
+    relate: 11,
+} as const;
+
+/** @internal */
+export type PairwiseOp = keyof typeof PairwiseOpIdMap;
+
+/** @internal */
+export interface PairwiseParams extends BatchOptions {
+    param?: number;
+    ptrParam?: Ptr<any>;
+    pattern?: string;
+    /** f64 values per element, for f64 results only */
+    width?: number;
+    /** bytes per element, for u8 results only */
+    record?: number;
+    /** do not throw on failures, failed elements are just `NaN` */
+    lenient?: boolean;
+    /** prepared geometry of a single `as`, instead of its own one */
+    prepared?: Ptr<GEOSPreparedGeometry>;
+}
+
+
+/**
+ * Calls `pairwise_r` and passes its output buffer to `read`.
+ *
+ * Buffer layout, in u32 units:
+ * `[as: na][bs: nb][out: n * 2 * width, 8-byte aligned][errors: n bytes][pattern]`
+ */
+const pairwise = <T, >(
+    op: PairwiseOp,
+    as: Geometry | Geometry[],
+    bs: Geometry | Geometry[] | null,
+    params: PairwiseParams | undefined,
+    read: (outPtr: number, n: number, shouldThrow: boolean) => T,
+): T => {
+    const aIsArray = Array.isArray(as), bIsArray = Array.isArray(bs);
+    const na = aIsArray ? as.length : 1;
+    const nb = bIsArray ? bs.length : (bs ? 1 : 0);
+    if (aIsArray && bIsArray && na !== nb) {
+        throw new GEOSError(`Arrays must have the same length, got ${na} and ${nb}`);
+    }
+    const n = aIsArray ? na : (bIsArray ? nb : 1);
+    const errors = params?.errors;
+    if (errors && errors.length < n) {
+        throw new GEOSError(`Errors array is too short, expected at least ${n} elements`);
+    }
+
+    const pattern = params?.pattern;
+    const width = params?.width ?? Math.ceil((params?.record ?? 1) / 8); // in 8-byte units
+    const outL4 = (na + nb + 1) & ~1; // 8-byte aligned start of `out`
+    const patternL4 = outL4 + n * 2 * width + Math.ceil(n / 4);
+    const buff = geos.buffByL4(patternL4 + (pattern ? Math.ceil((pattern.length + 1) / 4) : 0));
+    try {
+        const ptr = buff[ POINTER ];
+        let B = geos.U32, b = buff.i4;
+        if (aIsArray) {
+            for (const geometry of as) {
+                B[ b++ ] = geometry[ POINTER ];
+            }
+        } else {
+            B[ b++ ] = as[ POINTER ];
+        }
+        if (bIsArray) {
+            for (const geometry of bs) {
+                B[ b++ ] = geometry[ POINTER ];
+            }
+        } else if (bs) {
+            B[ b ] = bs[ POINTER ];
+        }
+
+        let ptrParam = params?.ptrParam || 0;
+        if (pattern) {
+            ptrParam = ptr + patternL4 * 4 as Ptr<string>;
+            geos.encodeStringAt(pattern, ptrParam);
+        }
+
+        const outPtr = ptr + outL4 * 4, errorsPtr = outPtr + n * 8 * width;
+        let failed: number;
+        try {
+            failed = geos.pairwise(
+                PairwiseOpIdMap[ op ],
+                ptr, +aIsArray,
+                ptr + na * 4 as Ptr<GEOSGeometry[]>, +bIsArray,
+                n,
+                aIsArray ? 0 : (params?.prepared || as[ P_POINTER ] || 0),
+                params?.param ?? NaN,
+                ptrParam,
+                outPtr as Ptr<any>,
+                errorsPtr as Ptr<any>,
+            );
+        } finally {
+            geos.error_capture_end();
+        }
+
+        if (errors) {
+            errors.set(geos.U8.subarray(errorsPtr, errorsPtr + n));
+        }
+        return read(outPtr, n, failed > 0 && !errors && !params?.lenient);
+    } finally {
+        buff.freeIfTmp();
+    }
+};
+
+/**
+ * Throws the first error captured during the last batch call.
+ * @internal
+ */
+export const throwCapturedError = (): void => {
+    geos.onGEOSError(geos.captured_error_message(), 0 as Ptr<void>);
+};
+
+
+/**
+ * Evaluates element-wise operation with geometry results.
+ * @internal
+ */
+export function pairwiseGeometries(op: PairwiseOp, as: Geometry | Geometry[], bs: Geometry | Geometry[] | null, params?: PairwiseParams): (Geometry | null)[] {
+    return pairwise(op, as, bs, params, (outPtr, n, shouldThrow) => {
+        const B = geos.U32, o = outPtr / 4; // [ptr, type id] pairs
+        if (shouldThrow) {
+            for (let i = 0; i < n; i++) {
+                if (B[ o + i * 2 ]) {
+                    geos.GEOSGeom_destroy(B[ o + i * 2 ] as Ptr<GEOSGeometry>);
+                }
+            }
+            throwCapturedError();
+        }
+        const results = Array<Geometry | null>(n);
+        for (let i = 0; i < n; i++) {
+            const geomPtr = B[ o + i * 2 ] as Ptr<GEOSGeometry>;
+            results[ i ] = geomPtr
+                ? new GeometryRef(geomPtr, GEOSGeometryTypeDecoder[ B[ o + i * 2 + 1 ] ]) as Geometry
+                : null;
+        }
+        return results;
+    });
+}
+
+/**
+ * Evaluates element-wise operation with numeric results.
+ * @internal
+ */
+export function pairwiseF64(op: PairwiseOp, as: Geometry | Geometry[], bs: Geometry | Geometry[] | null, params?: PairwiseParams): Float64Array {
+    return pairwise(op, as, bs, params, (outPtr, n, shouldThrow) => {
+        if (shouldThrow) {
+            throwCapturedError();
+        }
+        return geos.F64.slice(outPtr / 8, outPtr / 8 + n * (params?.width ?? 1));
+    });
+}
+
+/**
+ * Evaluates element-wise operation with boolean results.
+ * @internal
+ */
+export function pairwiseU8(op: PairwiseOp, as: Geometry | Geometry[], bs: Geometry | Geometry[] | null, params?: PairwiseParams): Uint8Array {
+    return pairwise(op, as, bs, params, (outPtr, n, shouldThrow) => {
+        if (shouldThrow) {
+            throwCapturedError();
+        }
+        return geos.U8.slice(outPtr, outPtr + n * (params?.record ?? 1));
+    });
+}
@@ -1,4 +1,5 @@
 import type { Ptr } from './types/WasmGEOS.mjs';
+import type { WasmOther } from './types/WasmOther.mjs';
 import { POINTER } from './symbols.mjs';
 import { geos } from './geos.mjs';
 
@@ -21,7 +22,7 @@ export class ReusableBuffer {
 
     freeIfTmp(): void {
         if (this !== geos.buff) {
-            geos.free(this[ POINTER ]);
+            geos.s_b.release(this);
         }
     }
 
@@ -82,3 +83,113 @@ export class ReusableF64 {
     }
 
 }
+
+
+export interface ScratchBufferStats {
+    /** Current size of the scratch buffer in bytes, 0 when not allocated */
+    size: number;
+    /** Number of scratch buffer (re)allocations */
+    resizes: number;
+    /** Number of requests served by temporary buffers, when the scratch buffer was in use or the request exceeded the maximum */
+    tmpAllocations: number;
+    /** Number of times the scratch buffer was released after an idle period */
+    decays: number;
+}
+
+/**
+ * Buffer for requests larger than `geos.buff`, grows to the high-water mark
+ * instead of allocating a temporary buffer per call.
+ * Handed out to one user at a time, nested requests get temporary buffers,
+ * all of them are returned via {@link ReusableBuffer#freeIfTmp}.
+ */
+export class ScratchBuffer {
+
+    /** In bytes */
+    maximum: number = 16 * 1024 * 1024; // 16MB
+    /** In milliseconds */
+    idle: number = Infinity;
+
+    buff?: ReusableBuffer;
+    inUse: boolean = false;
+    lastUse: number = 0;
+    timer?: ReturnType<typeof setTimeout>;
+
+    readonly stats: ScratchBufferStats = { size: 0, resizes: 0, tmpAllocations: 0, decays: 0 };
+
+    /** The instance that owns the buffer, not the global `geos`, which could be terminated or replaced */
+    private readonly owner: Pick<WasmOther, 'malloc' | 'free'>;
+
+    constructor(owner: Pick<WasmOther, 'malloc' | 'free'>) {
+        this.owner = owner;
+    }
+
+    acquire(l: number): ReusableBuffer {
+        const { buff } = this;
+        if (!this.inUse && l <= this.maximum) {
+            this.inUse = true;
+            if (buff && l <= buff.l) {
+                return buff;
+            }
+            if (buff) {
+                this.owner.free(buff[ POINTER ]);
+                this.buff = undefined; // in case malloc throws
+            }
+            // grow at least by half to avoid a resize per slightly larger request
+            const size = Math.min(this.maximum, Math.ceil(Math.max(l, (buff?.l ?? 0) * 1.5) / 65536) * 65536);
+            this.buff = new ReusableBuffer(this.owner.malloc(size), size);
+            this.stats.size = size;
+            this.stats.resizes++;
+            return this.buff;
+        }
+        this.stats.tmpAllocations++;
+        return new ReusableBuffer(this.owner.malloc(l), l);
+    }
+
+    release(buff: ReusableBuffer): void {
+        if (buff === this.buff) {
+            this.inUse = false;
+            this.lastUse = performance.now();
+            if (this.idle !== Infinity && !this.timer) {
+                this.scheduleDecay(this.idle);
+            }
+        } else {
+            this.owner.free(buff[ POINTER ]);
+        }
+    }
+
+    /** Frees the buffer, unless it is in use */
+    trim(): void {
+        if (this.buff && !this.inUse) {
+            this.owner.free(this.buff[ POINTER ]);
+            this.buff = undefined;
+            this.stats.size = 0;
+        }
+    }
+
+    /** Forgets the buffer without freeing it, for when the owner memory was reset */
+    drop(): void {
+        clearTimeout(this.timer);
+        this.timer = undefined;
+        this.buff = undefined;
+        this.inUse = false;
+        this.stats.size = 0;
+    }
+
+    private scheduleDecay(delay: number): void {
+        const timer = this.timer = setTimeout(() => {
+            this.timer = undefined;
+            if (!this.buff || this.inUse) {
+                return;
+            }
+            const wait = this.lastUse + this.idle - performance.now();
+            if (wait > 0) {
+                this.scheduleDecay(wait);
+            } else {
+                this.trim();
+                this.stats.decays++;
+            }
+        }, delay);
+        (timer as { unref?(): void }).unref?.(); // do not keep Node.js process alive
+    }
+
+}
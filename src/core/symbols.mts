@@ -1,8 +1,17 @@
 export const POINTER: unique symbol = Symbol('ptr');
 export const FINALIZATION: unique symbol = Symbol('finalization_registry');
 export const CLEANUP: unique symbol = Symbol('cleanup');
+export const ENVELOPE: unique symbol = Symbol('envelope');
+export const MEMO: unique symbol = Symbol('memo');
+export const SCOPE: unique symbol = Symbol('scope');
+export const ARENA: unique symbol = Symbol('arena');
+export const SHARED: unique symbol = Symbol('shared');
+export const OWNER: unique symbol = Symbol('owner');
 
 // PreparedGeometry specific
 export const P_POINTER: unique symbol = Symbol('prepared:ptr');
 export const P_FINALIZATION: unique symbol = Symbol('prepared:finalization_registry');
 export const P_CLEANUP: unique symbol = Symbol('prepared:cleanup');
+
+// STRTree specific
+export const BUILD_TIME: unique symbol = Symbol('build_time');
@@ -1132,7 +1132,6 @@ export interface WasmGEOS {
      * of any type.
      * @param g - Input geometry
      * @returns Number of points in the geometry. -1 on exception.
-     * @deprecated this function is not exported
      */
     GEOSGetNumCoordinates(g: ConstPtr<GEOSGeometry>): i32;
 
@@ -3085,7 +3084,6 @@ export interface WasmGEOS {
      * @param y - y coordinate of point to test
      * @returns 1 on true, 0 on false, 2 on exception
      * @see GEOSContains
-     * @deprecated this function is not exported
      */
     GEOSPreparedContainsXY(pg1: ConstPtr<GEOSPreparedGeometry>, x: f64, y: f64): i8;
 
@@ -3157,7 +3155,6 @@ export interface WasmGEOS {
      * @param y - y coordinate of point to test
      * @returns 1 on true, 0 on false, 2 on exception
      * @see GEOSIntersects
-     * @deprecated this function is not exported
      */
     GEOSPreparedIntersectsXY(pg1: ConstPtr<GEOSPreparedGeometry>, x: f64, y: f64): i8;
 
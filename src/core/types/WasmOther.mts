@@ -1,8 +1,12 @@
-import type { ConstPtr, GEOSGeometry, Ptr, u32 } from './WasmGEOS.mjs';
+import type { ConstPtr, f64, GEOSGeometry, GEOSPreparedGeometry, Ptr, u32, u8 } from './WasmGEOS.mjs';
 
 
 export type STRtree = 'STRtree';
 
+export type STRtreeStats = 'STRtreeStats';
+
+export type PointGrid = 'PointGrid';
+
 
 export interface WasmOther {
 
@@ -27,10 +31,16 @@ export interface WasmOther {
     geosify_geomsCoords(buff: Ptr<void>): void;
 
     /**
-     * Creates instances of `GEOSGeometry`.
+     * Creates instances of `GEOSGeometry`, writes their envelopes.
      * @see {@link import('../../io/geosify.mjs')}
      */
-    geosify_geoms(buff: Ptr<void>): void;
+    geosify_geoms(buff: Ptr<void>, envelopes: Ptr<f64[]>): void;
+
+    /**
+     * Writes envelope of the geometry, NaNs when empty or curved.
+     * @see {@link import('../../geom/envelope.mjs')}
+     */
+    geom_envelope(geom: ConstPtr<GEOSGeometry>, out: Ptr<f64[]>): void;
 
     /**
      * Writes geometries data into buffer.
@@ -39,14 +49,135 @@ export interface WasmOther {
     jsonify_geoms(buff: Ptr<void>): void;
 
 
-    STRtree_create(geoms: Ptr<GEOSGeometry[]>, ngeoms: u32, nodeCapacity: u32): Ptr<STRtree>;
+    STRtree_create(geoms: Ptr<GEOSGeometry[]>, ngeoms: u32, nodeCapacity: u32, withStats: u32): Ptr<STRtree>;
+
+    STRtree_stats(tree: Ptr<STRtree>): Ptr<STRtreeStats> | 0;
 
     STRtree_destroy(tree: Ptr<STRtree>): void;
 
-    STRtree_query(tree: Ptr<STRtree>, g: ConstPtr<GEOSGeometry>, matchesLength: Ptr<u32>): Ptr<u32> | 0;
+    STRtree_query(tree: Ptr<STRtree>, g: ConstPtr<GEOSGeometry>, matchesLength: Ptr<u32>): Ptr<u32>;
+
+    STRtree_queryBBox(tree: Ptr<STRtree>, xMin: f64, yMin: f64, xMax: f64, yMax: f64, matchesLength: Ptr<u32>): Ptr<u32>;
+
+    STRtree_queryBBoxes(tree: Ptr<STRtree>, bboxes: Ptr<f64[]>, n: u32, matchesLength: Ptr<u32>): Ptr<u32>;
 
     STRtree_nearest(tree: Ptr<STRtree>, g: ConstPtr<GEOSGeometry>, matchesLength: Ptr<u32>): u32;
 
-    STRtree_nearestAll(tree: Ptr<STRtree>, g: ConstPtr<GEOSGeometry>, matchesLength: Ptr<u32>): Ptr<u32> | 0;
+    STRtree_nearestAll(tree: Ptr<STRtree>, g: ConstPtr<GEOSGeometry>, matchesLength: Ptr<u32>): Ptr<u32>;
+
+
+    PointGrid_create(xy: Ptr<f64[]>, n: u32, cellSize: f64): Ptr<PointGrid>;
+
+    PointGrid_destroy(grid: Ptr<PointGrid>): void;
+
+    PointGrid_queryBBox(grid: Ptr<PointGrid>, xMin: f64, yMin: f64, xMax: f64, yMax: f64, matchesLength: Ptr<u32>): Ptr<u32>;
+
+    PointGrid_queryRadius(grid: Ptr<PointGrid>, x: f64, y: f64, radius: f64, matchesLength: Ptr<u32>): Ptr<u32>;
+
+    PointGrid_nearest(grid: Ptr<PointGrid>, x: f64, y: f64, k: u32, matchesLength: Ptr<u32>): Ptr<u32>;
+
+
+    /**
+     * Calculates Hilbert codes of the geometries envelope centers.
+     * @see {@link import('../../spatial-indexes/hilbert.mjs')}
+     */
+    hilbert_codes(geoms: Ptr<GEOSGeometry[]>, n: u32, extent: Ptr<f64[]>, codes: Ptr<u32[]>, order: Ptr<u32[]> | 0): void;
+
+
+    /**
+     * Calculates structural hashes of the geometries.
+     * @see {@link import('../../other/hash.mjs')}
+     */
+    hash_geoms(geoms: Ptr<GEOSGeometry[]>, n: u32, hashes: Ptr<u32[]>): void;
+
+
+    /**
+     * Destroys many geometries and their prepared counterparts.
+     * @see {@link import('../../geom/scope.mjs')}
+     */
+    geoms_destroy(buff: Ptr<void>, n: u32): void;
+
+    /**
+     * Estimates memory footprint of many geometries.
+     * @see {@link import('../../other/heap.mjs')}
+     */
+    geoms_byte_size(geoms: Ptr<GEOSGeometry[]>, n: u32, sizes: Ptr<f64[]>): void;
+
+
+    /**
+     * Evaluates binary predicate between one geometry and many others.
+     * @see {@link import('../../spatial-predicates/many.mjs')}
+     */
+    predicates_many(op: u32, a: ConstPtr<GEOSGeometry>, pa: Ptr<GEOSPreparedGeometry> | 0, bs: Ptr<GEOSGeometry[]>, n: u32, pattern: Ptr<string> | 0, out: Ptr<u8[]>): void;
+
+    /**
+     * Evaluates prepared XY predicate between one geometry and many points.
+     * @see {@link import('../../spatial-predicates/many.mjs')}
+     */
+    predicates_xy_many(op: u32, pa: Ptr<GEOSPreparedGeometry>, xy: Ptr<f64[]>, n: u32, out: Ptr<u8[]>): void;
+
+
+    /**
+     * Returns the first error message captured during the last batch call.
+     */
+    captured_error_message(): Ptr<string>;
+
+    /**
+     * Restores the error handler replaced by the last batch call,
+     * has to be called after every batch call that captures errors.
+     */
+    error_capture_end(): void;
+
+    /**
+     * Returns the version of the interface between the module and the JS
+     * sources, missing in modules built before it was introduced.
+     */
+    abi_version?(): u32;
+
+    /**
+     * Returns pointer to `[ctx, buff]` - GEOS context and the reusable
+     * buffer, created by the first call, or by Wasm static initializer
+     * in builds with `GEOS_JS_EVAL_CTORS=ON`.
+     */
+    runtime_state(): Ptr<u32[]>;
+
+    /**
+     * Evaluates operation element-wise over aligned arrays of geometries.
+     * @see {@link import('../pairwise.mjs')}
+     */
+    pairwise(op: u32, as: Ptr<GEOSGeometry[]>, aStep: u32, bs: Ptr<GEOSGeometry[]>, bStep: u32, n: u32, pa: Ptr<GEOSPreparedGeometry> | 0, param: f64, ptrParam: Ptr<any> | 0, out: Ptr<any>, errors: Ptr<u8[]>): u32;
+
+    /**
+     * Computes row-major matrix of distances between two arrays of geometries.
+     * @see {@link import('../../measurement/distance.mjs')}
+     */
+    distance_matrix(as: Ptr<GEOSGeometry[]>, na: u32, bs: Ptr<GEOSGeometry[]>, nb: u32, maxDistance: f64, prepared: u32, out: Ptr<f64[]>): u32;
+
+
+    /**
+     * Returns pointer to `[heapSize, inUse, free, freeChunks, largestFree, allocations]`.
+     * Available only in builds with `GEOS_JS_MALLOC_HOOKS=ON`.
+     * @see {@link import('../../other/heap.mjs')}
+     */
+    heap_stats?(): Ptr<f64[]>;
+
+    /**
+     * Starts serving allocations from the job arena region.
+     * Available only in builds with `GEOS_JS_ARENA=ON`.
+     * @see {@link import('../../other/arena.mjs')}
+     */
+    arena_begin?(capacity: u32): u32;
+
+    /**
+     * Stops serving allocations from the job arena, discards its memory.
+     * Available only in builds with `GEOS_JS_ARENA=ON`.
+     */
+    arena_reset?(): void;
+
+    /**
+     * Returns pointer to `[capacity, used, allocations, fallbacks]`.
+     * Available only in builds with `GEOS_JS_ARENA=ON`.
+     */
+    arena_stats?(): Ptr<f64[]>;
 
 }
@@ -13,7 +13,7 @@ import type { CurvePolygon } from './types/CurvePolygon.mjs';
 import type { MultiCurve } from './types/MultiCurve.mjs';
 import type { MultiSurface } from './types/MultiSurface.mjs';
 import type { JSON_Feature, JSON_Geometry } from './types/JSON.mjs';
-import { CLEANUP, FINALIZATION, P_CLEANUP, P_FINALIZATION, P_POINTER, POINTER } from '../core/symbols.mjs';
+import { ARENA, CLEANUP, ENVELOPE, FINALIZATION, MEMO, OWNER, P_CLEANUP, P_FINALIZATION, P_POINTER, POINTER, SCOPE, SHARED } from '../core/symbols.mjs';
 import { feature, jsonifyGeometry } from '../io/jsonify.mjs';
 import { geos } from '../core/geos.mjs';
 
@@ -93,6 +93,30 @@ export interface GeometryExtras<P> {
 
 }
 
+/**
+ * Results of unary functions, cached on the geometry until it is mutated.
+ * @internal
+ */
+export interface GeometryMemo {
+    area?: number;
+    length?: number;
+    bounds?: [ xMin: number, yMin: number, xMax: number, yMax: number ];
+    isSimple?: boolean;
+    /** `isValid` result, with `isInvertedRingValid` as `isValidIR` */
+    isValid?: boolean;
+    isValidIR?: boolean;
+}
+
+/**
+ * Wasm geometry referenced by more than one {@link GeometryRef},
+ * destroyed when the last of them is freed or garbage collected.
+ * @internal
+ */
+export interface SharedGeometry {
+    readonly ptr: Ptr<GEOSGeometry>;
+    refs: number;
+}
+
 
 /**
  * Union type of all possible geometry types.
@@ -184,6 +208,8 @@ export class GeometryRef<P = unknown> {
      */
     normalize(): this {
         geos.GEOSNormalize(this[ POINTER ]);
+        delete this[ ENVELOPE ];
+        delete this[ MEMO ];
         return this;
     }
 
@@ -207,6 +233,8 @@ export class GeometryRef<P = unknown> {
      */
     orientPolygons(exterior: 'cw' | 'ccw' = 'cw'): this {
         geos.GEOSOrientPolygons(this[ POINTER ], +(exterior === 'cw'));
+        delete this[ ENVELOPE ];
+        delete this[ MEMO ];
         return this;
     }
 
@@ -222,7 +250,13 @@ export class GeometryRef<P = unknown> {
      */
     clone(): GeometryRef<P> {
         const geomPtr = geos.GEOSGeom_clone(this[ POINTER ]);
-        const copy = new GeometryRef<P>(geomPtr);
+        const copy = new GeometryRef<P>(geomPtr, this.type);
+        if (this[ ENVELOPE ] !== undefined) {
+            copy[ ENVELOPE ] = this[ ENVELOPE ]; // slots are never modified, only replaced
+        }
+        if (this[ MEMO ]) {
+            copy[ MEMO ] = { ...this[ MEMO ] };
+        }
         if (this.id != null) {
             copy.id = this.id;
         }
@@ -275,14 +309,17 @@ export class GeometryRef<P = unknown> {
      * Wasm resource becomes invalid and cannot be used anymore.
      *
      * @see {@link GeometryRef#detached}
+     * @see {@link freeAll} frees many geometries at once
      */
     free(): void {
+        const owner = this[ OWNER ];
         if (this[ P_POINTER ]) {
-            GeometryRef[ P_FINALIZATION ].unregister(this);
-            GeometryRef[ P_CLEANUP ](this[ P_POINTER ]);
+            GeometryRef[ P_FINALIZATION ](this).unregister(this);
+            GeometryRef[ P_CLEANUP ](this[ P_POINTER ], owner);
+            delete this[ P_POINTER ];
         }
-        GeometryRef[ FINALIZATION ].unregister(this);
-        GeometryRef[ CLEANUP ](this[ POINTER ]);
+        GeometryRef[ FINALIZATION ](this).unregister(this);
+        GeometryRef[ CLEANUP ](this[ SHARED ] || this[ POINTER ], owner);
         this.detached = true;
     }
 
@@ -290,12 +327,35 @@ export class GeometryRef<P = unknown> {
     /** @internal */
     [ POINTER ]: Ptr<GEOSGeometry>;
 
+    /**
+     * The instance that owns the Wasm geometry, the active `geos` at the creation
+     * @internal
+     */
+    [ OWNER ]: typeof geos;
+
     /** @internal */
     declare [ P_POINTER ]?: Ptr<GEOSPreparedGeometry>;
 
+    /**
+     * `null` when empty or curved, `undefined` when not computed yet, see `envelopeOf`
+     * @internal
+     */
+    declare [ ENVELOPE ]?: Float64Array | null;
+
+    /** @internal */
+    declare [ MEMO ]?: GeometryMemo;
+
+    /**
+     * Set when the Wasm geometry is shared with other refs, see `shareGeometry`
+     * @internal
+     */
+    declare [ SHARED ]?: SharedGeometry;
+
     /** @internal */
     constructor(ptr: Ptr<GEOSGeometry>, type?: typeof GEOSGeometryTypeDecoder[number], extras?: GeometryExtras<P>) {
-        GeometryRef[ FINALIZATION ].register(this, ptr, this);
+        this[ OWNER ] = geos;
+        GeometryRef[ FINALIZATION ](this).register(this, ptr, this);
+        GeometryRef[ SCOPE ]?.push(this);
         this[ POINTER ] = ptr;
         this.type = type || GEOSGeometryTypeDecoder[ geos.GEOSGeomTypeId(ptr) ];
         if (extras) {
@@ -308,24 +368,73 @@ export class GeometryRef<P = unknown> {
         }
     }
 
-    /** @internal */
-    static readonly [ FINALIZATION ] = (
-        new FinalizationRegistry(GeometryRef[ CLEANUP ])
-    );
+    /**
+     * Geometries created in the innermost active {@link scope}
+     * @internal
+     */
+    static [ SCOPE ]?: GeometryRef[];
 
-    /** @internal */
-    static readonly [ P_FINALIZATION ] = (
-        new FinalizationRegistry(GeometryRef[ P_CLEANUP ])
-    );
+    /**
+     * Geometries prepared while the job arena is active, see {@link beginArena}
+     * @internal
+     */
+    static [ ARENA ]?: GeometryRef[];
+
+    /**
+     * Finalization registry of the instance that owns `geometry`
+     * @internal
+     */
+    static [ FINALIZATION ](geometry: GeometryRef<any>): FinalizationRegistry<Ptr<GEOSGeometry> | SharedGeometry> {
+        const owner = geometry[ OWNER ];
+        return owner.f_g ||= new FinalizationRegistry(held => GeometryRef[ CLEANUP ](held, owner));
+    }
+
+    /**
+     * Finalization registry of prepared geometries of the instance that owns `geometry`
+     * @internal
+     */
+    static [ P_FINALIZATION ](geometry: GeometryRef<any>): FinalizationRegistry<Ptr<GEOSPreparedGeometry>> {
+        const owner = geometry[ OWNER ];
+        return owner.f_p ||= new FinalizationRegistry(pPtr => GeometryRef[ P_CLEANUP ](pPtr, owner));
+    }
 
     /** @internal */
-    static [ CLEANUP ](ptr: Ptr<GEOSGeometry>): void {
-        geos.GEOSGeom_destroy(ptr);
+    static [ CLEANUP ](held: Ptr<GEOSGeometry> | SharedGeometry, owner: typeof geos): void {
+        if (typeof held === 'number') {
+            owner.GEOSGeom_destroy(held);
+        } else if (!--held.refs) {
+            owner.GEOSGeom_destroy(held.ptr);
+        }
     }
 
     /** @internal */
-    static [ P_CLEANUP ](ptr: Ptr<GEOSPreparedGeometry>): void {
-        geos.GEOSPreparedGeom_destroy(ptr);
+    static [ P_CLEANUP ](ptr: Ptr<GEOSPreparedGeometry>, owner: typeof geos): void {
+        owner.a_p?.forget(ptr);
+        owner.GEOSPreparedGeom_destroy(ptr);
     }
 
 }
+
+
+/**
+ * Creates another ref to the Wasm geometry of `geometry`, with its own
+ * `id` and `props`. The Wasm geometry is destroyed when the last of the refs
+ * is freed or garbage collected.
+ * @internal
+ */
+export const shareGeometry = <P>(geometry: Geometry<P>, extras?: GeometryExtras<P>): Geometry<P> => {
+    const registry = GeometryRef[ FINALIZATION ](geometry);
+    let shared = geometry[ SHARED ];
+    if (!shared) {
+        shared = geometry[ SHARED ] = { ptr: geometry[ POINTER ], refs: 1 };
+        registry.unregister(geometry);
+        registry.register(geometry, shared, geometry);
+    }
+    const ref = new GeometryRef(shared.ptr, geometry.type, extras) as Geometry<P>;
+    registry.unregister(ref);
+    registry.register(ref, shared, ref);
+    shared.refs++;
+    ref[ SHARED ] = shared;
+    ref[ ENVELOPE ] = geometry[ ENVELOPE ];
+    return ref;
+};
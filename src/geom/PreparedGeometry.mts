@@ -1,5 +1,7 @@
+import type { GEOSPreparedGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
 import { type Geometry, GeometryRef } from './Geometry.mjs';
-import { P_CLEANUP, P_FINALIZATION, P_POINTER, POINTER } from '../core/symbols.mjs';
+import { ARENA, OWNER, P_CLEANUP, P_FINALIZATION, P_POINTER, POINTER } from '../core/symbols.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
 import { geos } from '../core/geos.mjs';
 
 
@@ -84,8 +86,9 @@ export type Prepared<G extends Geometry> = G & { [ __PREPARED__ ]: true }; // br
 export function prepare<G extends Geometry>(geometry: G): Prepared<G> {
     if (!geometry[ P_POINTER ]) {
         const pPtr = geos.GEOSPrepare(geometry[ POINTER ]);
-        GeometryRef[ P_FINALIZATION ].register(geometry, pPtr, geometry);
+        GeometryRef[ P_FINALIZATION ](geometry).register(geometry, pPtr, geometry);
         geometry[ P_POINTER ] = pPtr;
+        GeometryRef[ ARENA ]?.push(geometry);
     }
     return geometry as Prepared<G>;
 }
@@ -125,9 +128,180 @@ export function prepare<G extends Geometry>(geometry: G): Prepared<G> {
  */
 export function unprepare<G extends Geometry>(geometry: Prepared<G>): G {
     if (geometry[ P_POINTER ]) {
-        GeometryRef[ P_FINALIZATION ].unregister(geometry);
-        GeometryRef[ P_CLEANUP ](geometry[ P_POINTER ]);
+        GeometryRef[ P_FINALIZATION ](geometry).unregister(geometry);
+        GeometryRef[ P_CLEANUP ](geometry[ P_POINTER ], geometry[ OWNER ]);
         delete geometry[ P_POINTER ];
     }
     return geometry as G;
 }
+
+
+export interface AutoPrepareOptions {
+
+    /**
+     * Number of calls of the functions that benefit from preparation (see
+     * {@link prepare}), with the geometry as the first argument, after which
+     * the geometry gets prepared.
+     * @default 3
+     */
+    minUses?: number;
+
+    /**
+     * Number of vertices from which the geometry gets prepared already on
+     * the first call.
+     * @default 1000
+     */
+    minVertices?: number;
+
+    /**
+     * Limit of the total number of vertices of automatically prepared
+     * geometries. The size of prepared indexes is proportional to the number
+     * of vertices, so this caps the memory used by them.\
+     * When exceeded, the least recently used automatically prepared
+     * geometries are [unprepared]{@link unprepare}.
+     * @default 1_000_000
+     */
+    maxPreparedVertices?: number;
+
+}
+
+/**
+ * Enables or disables automatic geometry preparation.
+ *
+ * When enabled, calls of the functions that benefit from preparation
+ * (see {@link prepare}) are counted per geometry, and the geometry passed
+ * as the first argument is prepared transparently once it is used often
+ * enough, or right away when it is large enough.
+ * Total size of automatically prepared geometries is capped, the least
+ * recently used ones are unprepared first.
+ *
+ * Geometries prepared manually via {@link prepare} are never unprepared
+ * automatically and do not count towards the limit.
+ *
+ * Disabling does not unprepare already prepared geometries.
+ *
+ * @param options - Heuristics options, or `false` to disable
+ *
+ * @see {@link prepare} to prepare geometry manually
+ *
+ * @example
+ * autoPrepare({ minUses: 2, maxPreparedVertices: 100_000 });
+ * const zone = buffer(point([ 0, 0 ]), 10);
+ * contains(zone, point([ 1, 1 ])); // first use
+ * contains(zone, point([ 2, 2 ])); // second use, `zone` gets prepared
+ * const prepared = isPrepared(zone); // true
+ * autoPrepare(false);
+ */
+export function autoPrepare(options: AutoPrepareOptions | false): void {
+    geos.a_p = options ? new AutoPrepareCache(options) : undefined;
+}
+
+
+/**
+ * Tracks geometry uses and automatically prepared geometries.
+ * @internal
+ */
+export class AutoPrepareCache {
+
+    readonly minUses: number;
+    readonly minVertices: number;
+    readonly maxPreparedVertices: number;
+
+    /** Uses of not yet prepared geometries */
+    readonly uses: WeakMap<Geometry, number> = new WeakMap();
+    /** Automatically prepared geometries in LRU order, the least recently used first */
+    readonly prepared: Map<Ptr<GEOSPreparedGeometry>, { ref: WeakRef<Geometry>, vertices: number }> = new Map();
+    preparedVertices: number = 0;
+
+    constructor(options: AutoPrepareOptions) {
+        const { minUses = 3, minVertices = 1000, maxPreparedVertices = 1_000_000 } = options;
+        if (!(minUses >= 1 && minVertices >= 0 && maxPreparedVertices >= 0)) {
+            throw new GEOSError('Invalid auto prepare options');
+        }
+        this.minUses = minUses;
+        this.minVertices = minVertices;
+        this.maxPreparedVertices = maxPreparedVertices;
+    }
+
+    /**
+     * Registers geometry use, returns prepared geometry pointer when the
+     * geometry is or just has been prepared.
+     */
+    use(geometry: Geometry): Ptr<GEOSPreparedGeometry> | undefined {
+        let pPtr = geometry[ P_POINTER ];
+        if (pPtr) {
+            const entry = this.prepared.get(pPtr);
+            if (entry) { // move to the end - the most recently used
+                this.prepared.delete(pPtr);
+                this.prepared.set(pPtr, entry);
+            }
+            return pPtr;
+        }
+
+        const uses = (this.uses.get(geometry) ?? 0) + 1;
+        if (uses === 1 || uses >= this.minUses) {
+            const vertices = geos.GEOSGetNumCoordinates(geometry[ POINTER ]);
+            if ((uses >= this.minUses || vertices >= this.minVertices) && vertices <= this.maxPreparedVertices) {
+                this.uses.delete(geometry);
+                pPtr = prepare(geometry)[ P_POINTER ]!;
+                this.prepared.set(pPtr, { ref: new WeakRef(geometry), vertices });
+                this.preparedVertices += vertices;
+                this.evict();
+                return pPtr;
+            }
+        }
+        this.uses.set(geometry, uses);
+    }
+
+    /** Unprepares the least recently used geometries until the limit is met */
+    evict(): void {
+        for (const [ pPtr, { ref, vertices } ] of this.prepared) {
+            if (this.preparedVertices <= this.maxPreparedVertices) {
+                break;
+            }
+            this.prepared.delete(pPtr);
+            this.preparedVertices -= vertices;
+            const geometry = ref.deref();
+            if (geometry && geometry[ P_POINTER ] === pPtr) {
+                unprepare(geometry as Prepared<Geometry>);
+            }
+        }
+    }
+
+    /**
+     * Drops the entry of a prepared geometry that is being destroyed, so
+     * that it no longer counts towards the limit. Called wherever prepared
+     * geometries are destroyed or discarded: `free`, `unprepare`, bulk
+     * destroy, finalizers and arena reset.
+     */
+    forget(pPtr: Ptr<GEOSPreparedGeometry>): void {
+        const entry = this.prepared.get(pPtr);
+        if (entry) {
+            this.prepared.delete(pPtr);
+            this.preparedVertices -= entry.vertices;
+        }
+    }
+
+}
+
+
+/**
+ * Returns prepared geometry pointer when the geometry is prepared, also
+ * when it gets prepared automatically, see {@link autoPrepare}.
+ * @internal
+ */
+export const preparedPtr = (geometry: Geometry): Ptr<GEOSPreparedGeometry> | undefined => (
+    geos.a_p ? geos.a_p.use(geometry) : geometry[ P_POINTER ]
+);
+
+/**
+ * Returns prepared geometry pointer for a one-vs-many batch call: the one of
+ * an already (or automatically) prepared geometry, or a temporary one, which
+ * the caller has to destroy with `GEOSPreparedGeom_destroy` when `temporary`
+ * is `true`, so that the batch does not leave the geometry prepared.
+ * @internal
+ */
+export const batchPreparedPtr = (geometry: Geometry): [ pPtr: Ptr<GEOSPreparedGeometry>, temporary: boolean ] => {
+    const pPtr = preparedPtr(geometry);
+    return pPtr ? [ pPtr, false ] : [ geos.GEOSPrepare(geometry[ POINTER ]), true ];
+};
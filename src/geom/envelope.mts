@@ -0,0 +1,87 @@
+import type { Geometry } from './Geometry.mjs';
+import { ENVELOPE, POINTER } from '../core/symbols.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+/**
+ * Envelopes of geometries are stored in 4-element slots `[ xMin, yMin, xMax, yMax ]`
+ * of shared slabs, to avoid a separate `ArrayBuffer` per geometry.
+ * A slab is released when all geometries using its slots are collected.
+ */
+const SLAB_LENGTH = 4 * 1024;
+let slab = new Float64Array(SLAB_LENGTH);
+let s = 0;
+
+/**
+ * Copies 4 values from `F` at index `f` into a new envelope slot.
+ * @internal
+ */
+export const envelopeSlot = (F: Float64Array, f: number): Float64Array => {
+    if (s === SLAB_LENGTH) {
+        slab = new Float64Array(SLAB_LENGTH);
+        s = 0;
+    }
+    const slot = slab.subarray(s, s += 4);
+    slot[ 0 ] = F[ f ];
+    slot[ 1 ] = F[ f + 1 ];
+    slot[ 2 ] = F[ f + 2 ];
+    slot[ 3 ] = F[ f + 3 ];
+    return slot;
+};
+
+
+/**
+ * Returns the cached envelope of the geometry, `null` when empty or curved.
+ * Geometries created from GeoJSON get it at creation, the others
+ * (from WKT, WKB, operation results...) on the first call.
+ * @internal
+ */
+export const envelopeOf = (geometry: Geometry): Float64Array | null => {
+    let e = geometry[ ENVELOPE ];
+    if (e === undefined) {
+        const ptr = geos.f1[ POINTER ]; // f1-f4 are consecutive
+        geos.geom_envelope(geometry[ POINTER ], ptr);
+        const F = geos.F64, f = ptr / 8;
+        e = geometry[ ENVELOPE ] = Number.isNaN(F[ f ]) ? null : envelopeSlot(F, f);
+    }
+    return e;
+};
+
+
+/*
+ * Envelope based pre-filters; they return `true` only when it is certain.
+ * Envelopes are known only for non-empty, non-curved geometries, otherwise
+ * the decision is left to GEOS.
+ */
+
+/**
+ * Whether envelopes of `a` and `b` are known to be disjoint.
+ * @internal
+ */
+export const envelopesDisjoint = (a: Geometry, b: Geometry): boolean => {
+    const ea = envelopeOf(a), eb = ea && envelopeOf(b);
+    return Boolean(ea && eb && (ea[ 2 ] < eb[ 0 ] || eb[ 2 ] < ea[ 0 ] || ea[ 3 ] < eb[ 1 ] || eb[ 3 ] < ea[ 1 ]));
+};
+
+/**
+ * Whether envelope of `b` is known not to be covered by envelope of `a`.
+ * @internal
+ */
+export const envelopeNotCovers = (a: Geometry, b: Geometry): boolean => {
+    const ea = envelopeOf(a), eb = ea && envelopeOf(b);
+    return Boolean(ea && eb && !(ea[ 0 ] <= eb[ 0 ] && ea[ 1 ] <= eb[ 1 ] && eb[ 2 ] <= ea[ 2 ] && eb[ 3 ] <= ea[ 3 ]));
+};
+
+/**
+ * Whether envelopes of `a` and `b` are known to be further apart than `maxDistance`.
+ * @internal
+ */
+export const envelopesFurtherThan = (a: Geometry, b: Geometry, maxDistance: number): boolean => {
+    const ea = envelopeOf(a), eb = ea && envelopeOf(b);
+    if (ea && eb) {
+        const dx = Math.max(eb[ 0 ] - ea[ 2 ], ea[ 0 ] - eb[ 2 ], 0);
+        const dy = Math.max(eb[ 1 ] - ea[ 3 ], ea[ 1 ] - eb[ 3 ], 0);
+        return Math.sqrt(dx * dx + dy * dy) > maxDistance;
+    }
+    return false;
+};
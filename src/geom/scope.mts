@@ -0,0 +1,177 @@
+import { GeometryRef } from './Geometry.mjs';
+import { FINALIZATION, P_FINALIZATION, P_POINTER, POINTER, SCOPE, SHARED } from '../core/symbols.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+/**
+ * Runs `fn` and frees all the geometries created during the call, except
+ * the ones that escape it.
+ *
+ * A geometry escapes the scope when it is:
+ * - returned from `fn`, directly, as an element of a returned array or as
+ *   a property value of a returned plain object, like `{ a, b }` (nested
+ *   arrays and plain objects included),
+ * - passed to the `keep` function provided as the `fn` argument.
+ *
+ * Other geometries are freed in a single Wasm call when `fn` returns or
+ * throws, instead of lingering in Wasm memory until they are garbage collected.
+ * This keeps the memory usage of loops with intermediate results, like
+ * `union(buffer(a, 1), buffer(b, 1))`, flat.
+ *
+ * Scopes can be nested, geometries that escape the inner scope belong to
+ * the outer one.
+ *
+ * `fn` has to be synchronous, geometries created after it returns, for
+ * example in a `then` callback, are not tracked.
+ *
+ * @template T - The type of the `fn` result
+ * @param fn - Function to run, receives `keep` function that marks
+ * a geometry as escaping and returns it
+ * @returns The result of `fn`
+ *
+ * @see {@link GeometryRef#free} frees a single geometry
+ *
+ * @example #live
+ * const a = point([ 0, 0 ]), b = point([ 2, 0 ]);
+ * const result = scope(() => {
+ *     // both buffers are freed when the scope exits
+ *     return union(buffer(a, 1), buffer(b, 1));
+ * });
+ *
+ * @example #live keep intermediate results
+ * let circle;
+ * const clippedArea = scope((keep) => {
+ *     circle = keep(buffer(point([ 0, 0 ]), 1));
+ *     return area(intersection(circle, box([ 0, 0, 1, 1 ])));
+ * });
+ */
+export function scope<T>(fn: (keep: <G extends GeometryRef<any>>(geometry: G) => G) => T): T {
+    const outer = GeometryRef[ SCOPE ];
+    const created: GeometryRef[] = GeometryRef[ SCOPE ] = [];
+    const kept = new Set<GeometryRef>();
+    try {
+        const result = fn((geometry) => {
+            kept.add(geometry);
+            return geometry;
+        });
+        collectEscaping(result, kept);
+        return result;
+    } finally {
+        GeometryRef[ SCOPE ] = outer;
+        const dead: GeometryRef[] = [];
+        for (const geometry of created) {
+            if (kept.has(geometry)) {
+                outer?.push(geometry);
+            } else if (!geometry.detached) {
+                dead.push(geometry);
+            }
+        }
+        destroyGeometries(dead);
+    }
+}
+
+
+/**
+ * Frees the Wasm memory of many geometries at once.
+ *
+ * Same as calling [free]{@link GeometryRef#free} on each geometry, but
+ * the geometries, and their [prepared]{@link prepare} counterparts, are
+ * destroyed in a single Wasm call. Use it to tear down large datasets.
+ *
+ * Already detached geometries are skipped, and geometries that appear in
+ * the array more than once are freed once.
+ *
+ * @param geometries - The array of geometries to free
+ *
+ * @see {@link GeometryRef#free} frees a single geometry
+ * @see {@link scope} frees geometries created by a function
+ *
+ * @example #live
+ * const geometries = Array.from({ length: 1000 }, (_, i) => point([ i, i ]));
+ * freeAll(geometries);
+ * const isDetached = geometries[ 0 ].detached; // true
+ */
+export function freeAll(geometries: GeometryRef<any>[]): void {
+    const alive = new Set<GeometryRef>();
+    for (const geometry of geometries) {
+        if (!geometry.detached) {
+            alive.add(geometry);
+        }
+    }
+    destroyGeometries(Array.from(alive));
+}
+
+
+const collectEscaping = (value: unknown, kept: Set<GeometryRef>, visited = new Set<object>()): void => {
+    if (value instanceof GeometryRef) {
+        kept.add(value);
+    } else if (typeof value === 'object' && value && !visited.has(value)) {
+        visited.add(value);
+        if (Array.isArray(value)) {
+            for (const v of value) {
+                collectEscaping(v, kept, visited);
+            }
+        } else {
+            const proto = Object.getPrototypeOf(value);
+            if (proto === Object.prototype || proto === null) { // plain objects only
+                for (const v of Object.values(value)) {
+                    collectEscaping(v, kept, visited);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Frees not detached, distinct geometries and their prepared counterparts
+ * in a single Wasm call.
+ * @internal
+ */
+export const destroyGeometries = (geometries: GeometryRef[]): void => {
+    const n = geometries.length;
+    if (!n) {
+        return;
+    }
+    // [geometries: u32 x n][prepared: u32 x n]
+    const buff = geos.buffByL4(n * 2);
+    try {
+        const B = geos.U32;
+        let b = buff.i4;
+        for (const geometry of geometries) {
+            const pPtr = geometry[ P_POINTER ];
+            if (pPtr) {
+                GeometryRef[ P_FINALIZATION ](geometry).unregister(geometry);
+                geos.a_p?.forget(pPtr);
+                delete geometry[ P_POINTER ];
+            }
+            GeometryRef[ FINALIZATION ](geometry).unregister(geometry);
+            geometry.detached = true;
+            const shared = geometry[ SHARED ];
+            B[ b ] = shared && --shared.refs ? 0 : geometry[ POINTER ]; // still used by other refs
+            B[ b + n ] = pPtr || 0;
+            b++;
+        }
+        geos.geoms_destroy(buff[ POINTER ], n);
+    } finally {
+        buff.freeIfTmp();
+    }
+};
+
+
+/**
+ * Detaches geometries without freeing them, for when their memory is
+ * discarded at once, like on arena reset.
+ * @internal
+ */
+export const detachGeometries = (geometries: GeometryRef[]): void => {
+    for (const geometry of geometries) {
+        const pPtr = geometry[ P_POINTER ];
+        if (pPtr) {
+            GeometryRef[ P_FINALIZATION ](geometry).unregister(geometry);
+            geos.a_p?.forget(pPtr);
+            delete geometry[ P_POINTER ];
+        }
+        GeometryRef[ FINALIZATION ](geometry).unregister(geometry);
+        geometry.detached = true;
+    }
+};
@@ -14,7 +14,7 @@ import type { CurvePolygon } from '../geom/types/CurvePolygon.mjs';
 import type { ReusableBuffer } from '../core/reusable-memory.mjs';
 import type { GEOSGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
 import type { GeoJSONInputOptions } from '../io/GeoJSON.mjs';
-import { FINALIZATION, POINTER } from '../core/symbols.mjs';
+import { FINALIZATION, POINTER, SHARED } from '../core/symbols.mjs';
 import { type Geometry, type GeometryExtras, GeometryRef, GEOSGeometryTypeDecoder, GEOSGeomTypeIdMap } from '../geom/Geometry.mjs';
 import { geosifyGeometry } from '../io/geosify.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
@@ -530,8 +530,11 @@ const prepareGeometryArray = <P, >(buff: ReusableBuffer, geometries: Geometry[],
     let B = geos.U32, b = buff.i4;
     if (options?.consume) {
         for (const geometry of geometries) {
-            B[ b++ ] = geometry[ POINTER ];
-            GeometryRef[ FINALIZATION ].unregister(geometry);
+            const shared = geometry[ SHARED ];
+            B[ b++ ] = shared && --shared.refs // still used by other refs
+                ? geos.GEOSGeom_clone(geometry[ POINTER ])
+                : geometry[ POINTER ];
+            GeometryRef[ FINALIZATION ](geometry).unregister(geometry);
             geometry.detached = true;
         }
     } else {
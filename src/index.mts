@@ -63,7 +63,8 @@ export { terminate } from './core/geos.mjs';
 
 export { GEOSError } from './core/GEOSError.mjs';
 export { type Geometry, type GeometryRef, type GeometryType, type GeometryExtras, type CoordinateType } from './geom/Geometry.mjs';
-export { type Prepared, prepare, unprepare } from './geom/PreparedGeometry.mjs';
+export { type Prepared, prepare, unprepare, autoPrepare, type AutoPrepareOptions } from './geom/PreparedGeometry.mjs';
+export { freeAll, scope } from './geom/scope.mjs';
 export { type Point } from './geom/types/Point.mjs';
 export { type LineString } from './geom/types/LineString.mjs';
 export { type LinearRing } from './geom/types/LinearRing.mjs';
@@ -112,21 +113,22 @@ export { fromWKT, type WKTInputOptions, toWKT, type WKTOutputOptions } from './i
 export { fromWKB, type WKBInputOptions, toWKB, type WKBOutputOptions } from './io/WKB.mjs';
 
 export { type DensifyOptions } from './measurement/types/DensifyOptions.mjs';
-export { bounds } from './measurement/bounds.mjs';
-export { area } from './measurement/area.mjs';
-export { length } from './measurement/length.mjs';
-export { distance } from './measurement/distance.mjs';
+export { bounds, boundsMany } from './measurement/bounds.mjs';
+export { area, areaMany } from './measurement/area.mjs';
+export { length, lengthMany } from './measurement/length.mjs';
+export { distance, distanceMany, distanceMatrix, type DistanceMatrixOptions } from './measurement/distance.mjs';
 export { hausdorffDistance } from './measurement/hausdorffDistance.mjs';
 export { frechetDistance } from './measurement/frechetDistance.mjs';
 export { nearestPoints } from './measurement/nearestPoints.mjs';
 
+export { type BatchOptions } from './core/pairwise.mjs';
 export { type PrecisionGridOptions } from './operations/types/PrecisionGridOptions.mjs';
-export { buffer, type BufferOptions } from './operations/buffer.mjs';
-export { difference } from './operations/difference.mjs';
-export { intersection } from './operations/intersection.mjs';
-export { symmetricDifference } from './operations/symmetricDifference.mjs';
+export { buffer, bufferMany, type BufferOptions } from './operations/buffer.mjs';
+export { difference, differenceMany } from './operations/difference.mjs';
+export { intersection, intersectionMany } from './operations/intersection.mjs';
+export { symmetricDifference, symmetricDifferenceMany } from './operations/symmetricDifference.mjs';
 export { unaryUnion } from './operations/unaryUnion.mjs';
-export { union } from './operations/union.mjs';
+export { union, unionMany } from './operations/union.mjs';
 export { makeValid, type MakeValidOptions } from './operations/makeValid.mjs';
 export { simplify, type SimplifyOptions } from './operations/simplify.mjs';
 
@@ -137,18 +139,26 @@ export { isSimple } from './predicates/isSimple.mjs';
 export { isValid, isValidOrThrow, TopologyValidationError, type IsValidOptions } from './predicates/isValid.mjs';
 export { equalsExact } from './predicates/equalsExact.mjs';
 export { equalsIdentical } from './predicates/equalsIdentical.mjs';
-export { distanceWithin } from './predicates/distanceWithin.mjs';
+export { distanceWithin, distanceWithinMany } from './predicates/distanceWithin.mjs';
 
-export { equals } from './spatial-predicates/equals.mjs';
-export { intersects, disjoint } from './spatial-predicates/intersects.mjs';
-export { contains, containsProperly, within } from './spatial-predicates/contains.mjs';
-export { covers, coveredBy } from './spatial-predicates/covers.mjs';
-export { crosses } from './spatial-predicates/crosses.mjs';
-export { overlaps } from './spatial-predicates/overlaps.mjs';
-export { touches } from './spatial-predicates/touches.mjs';
-export { relate, relatePattern } from './spatial-predicates/relate.mjs';
+export { equals, equalsMany } from './spatial-predicates/equals.mjs';
+export { intersects, intersectsMany, intersectsXY, disjoint, disjointMany } from './spatial-predicates/intersects.mjs';
+export { contains, containsMany, containsXY, containsProperly, containsProperlyMany, within, withinMany } from './spatial-predicates/contains.mjs';
+export { covers, coversMany, coveredBy, coveredByMany } from './spatial-predicates/covers.mjs';
+export { crosses, crossesMany } from './spatial-predicates/crosses.mjs';
+export { overlaps, overlapsMany } from './spatial-predicates/overlaps.mjs';
+export { touches, touchesMany } from './spatial-predicates/touches.mjs';
+export { relate, relateMany, relatePattern, relatePatternMany } from './spatial-predicates/relate.mjs';
 
-export { type STRTreeRef, type STRTreeOptions, strTreeIndex } from './spatial-indexes/STRTree.mjs';
+export { type STRTreeRef, type STRTreeOptions, type STRTreeStats, strTreeIndex } from './spatial-indexes/STRTree.mjs';
+export { type PointGridRef, type PointGridOptions, pointGridIndex } from './spatial-indexes/PointGrid.mjs';
+export { hilbertCodes, hilbertSort } from './spatial-indexes/hilbert.mjs';
 
+export { type ArenaOptions, type ArenaStats, beginArena, resetArena } from './other/arena.mjs';
 export { growMemory } from './other/growMemory.mjs';
+export { createPool, type GEOSPool, type PoolOptions, type PoolStats } from './other/pool.mjs';
+export { type ScratchBufferOptions, type ScratchBufferStats, scratchBufferPolicy, scratchBufferStats } from './other/scratchBuffer.mjs';
+export { type MemoryGrowthOptions, type MemoryGrowthStats, memoryGrowthPolicy, memoryGrowthStats } from './other/memoryGrowth.mjs';
+export { hash } from './other/hash.mjs';
+export { byteSize, type HeapStats, heapStats } from './other/heap.mjs';
 export { version } from './other/version.mjs';
@@ -22,6 +22,24 @@ export interface GeoJSONInputOptions {
      */
     layout?: CoordinateType;
 
+    /**
+     * Whether features of a `FeatureCollection` with identical geometries
+     * should share a single geometry object.
+     *
+     * Use this when many features reference the same geometry, for example
+     * the same boundary, to keep only one copy of it in Wasm memory.
+     * Geometries are identical when they are [identical]{@link equalsIdentical}
+     * after parsing, see {@link hash}.
+     *
+     * Each feature still gets its own geometry object, with its own `id` and
+     * `props`, only the Wasm geometry is shared. It is destroyed when all the
+     * geometries that share it are freed. Functions that modify geometries
+     * in place, like {@link GeometryRef#normalize}, affect all of them.
+     *
+     * @default false
+     */
+    dedup?: boolean;
+
 }
 
 /**
@@ -100,7 +118,7 @@ export function fromGeoJSON<P>(
     const layout = options?.layout;
     switch (geojson.type) {
         case 'FeatureCollection': {
-            return geosifyFeatures(geojson.features, layout);
+            return geosifyFeatures(geojson.features, layout, options?.dedup);
         }
         case 'Feature': {
             return geosifyGeometry(geojson.geometry, layout, geojson);
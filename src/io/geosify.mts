@@ -87,16 +87,19 @@
  * D      *(u32) *GEOSGeometry -> pointer to the created GEOS Point
  * D      *(u32) *GEOSGeometry -> pointer to the created GEOS LineString
  * </pre>
+ * Envelopes of the created geometries are written right after the `F` part,
+ * 4 `f64` values per geometry: xMin, yMin, xMax, yMax (NaN when unknown).
  *
- * ## 6. [JS] retrieve pointers of `GEOSGeometry`
+ * ## 6. [JS] retrieve pointers of `GEOSGeometry` and their envelopes
  */
 declare const THIS_FILE: symbol; // to omit ^ @file doc from the bundle
 
 import type { LineString as GeoJSON_LineString, Position } from 'geojson';
 import type { JSON_CircularString, JSON_CompoundCurve, JSON_Feature, JSON_Geometry } from '../geom/types/JSON.mjs';
-import type { GEOSGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
-import { POINTER } from '../core/symbols.mjs';
-import { CollectionElementsKeyMap, type CoordinateType, type Geometry, type GeometryExtras, GeometryRef, type GeometryType, GEOSGeometryTypeDecoder, GEOSGeomTypeIdMap } from '../geom/Geometry.mjs';
+import type { f64, GEOSGeometry, Ptr, u32 } from '../core/types/WasmGEOS.mjs';
+import { ENVELOPE, POINTER } from '../core/symbols.mjs';
+import { CollectionElementsKeyMap, type CoordinateType, type Geometry, type GeometryExtras, GeometryRef, type GeometryType, GEOSGeometryTypeDecoder, GEOSGeomTypeIdMap, shareGeometry } from '../geom/Geometry.mjs';
+import { envelopeSlot } from '../geom/envelope.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { geos } from '../core/geos.mjs';
 
@@ -634,7 +637,7 @@ export function geosifyGeometry<P>(geojson: JSON_Geometry, layout?: CoordinateTy
     const o = CoordsOptionsMap[ layout || 'XYZM' ];
     const c: GeosifyCounter = { d: 0, s: 0, f: 0 };
     geosifyMeasureAndValidateGeom(geojson, c, o);
-    const buff = geos.buffByL4(3 + c.d + c.s + c.f * 2);
+    const buff = geos.buffByL4(3 + c.d + c.s + c.f * 2 + 8);
     try {
         let B = geos.U32;
         let d = buff.i4, s: number, f: number;
@@ -652,14 +655,18 @@ export function geosifyGeometry<P>(geojson: JSON_Geometry, layout?: CoordinateTy
             geosifyPopulateGeom(geojson, ps, o);
         }
 
-        geos.geosify_geoms(buff[ POINTER ]);
+        const e = f + c.f; // envelopes after `F`
+        geos.geosify_geoms(buff[ POINTER ], e * 8 as Ptr<f64[]>);
 
         B = geos.U32;
-        return new GeometryRef(
+        const geometry = new GeometryRef(
             B[ d ] as Ptr<GEOSGeometry>,
             geojson.type,
             extras,
         ) as Geometry<P>;
+        const F = geos.F64;
+        geometry[ ENVELOPE ] = Number.isNaN(F[ e ]) ? null : envelopeSlot(F, e); // NaN for empty and curved geometries
+        return geometry;
     } finally {
         buff.freeIfTmp();
     }
@@ -670,6 +677,8 @@ export function geosifyGeometry<P>(geojson: JSON_Geometry, layout?: CoordinateTy
  *
  * @param geojsons - Array of GeoJSON feature objects
  * @param layout - Input geometry coordinate layout
+ * @param dedup - Whether features with identical geometries should share
+ * a single Wasm geometry, each feature still gets its own geometry ref
  * @returns An array of new geometries
  * @throws {InvalidGeoJSONError} on GeoJSON feature without geometry
  * @throws {InvalidGeoJSONError} on invalid GeoJSON geometry
@@ -702,13 +711,14 @@ export function geosifyGeometry<P>(geojson: JSON_Geometry, layout?: CoordinateTy
  * line.type; // 'LineString'
  * collection.type; // 'GeometryCollection'
  */
-export function geosifyFeatures<P>(geojsons: JSON_Feature<JSON_Geometry, P>[], layout?: CoordinateType): Geometry<P>[] {
+export function geosifyFeatures<P>(geojsons: JSON_Feature<JSON_Geometry, P>[], layout?: CoordinateType, dedup?: boolean): Geometry<P>[] {
     const o = CoordsOptionsMap[ layout || 'XYZM' ];
     const c: GeosifyCounter = { d: 0, s: 0, f: 0 };
     for (const geom of geojsons) {
         geosifyMeasureAndValidateGeom(geom.geometry, c, o);
     }
-    const buff = geos.buffByL4(3 + c.d + c.s + c.f * 2);
+    const geometriesLength = geojsons.length;
+    const buff = geos.buffByL4(3 + c.d + c.s + c.f * 2 + geometriesLength * (dedup ? 9 : 8));
     try {
         let B = geos.U32;
         let d = buff.i4, s: number, f: number;
@@ -730,18 +740,49 @@ export function geosifyFeatures<P>(geojsons: JSON_Feature<JSON_Geometry, P>[], l
             }
         }
 
-        geos.geosify_geoms(buff[ POINTER ]);
+        let e = f + c.f; // envelopes after `F`
+        geos.geosify_geoms(buff[ POINTER ], e * 8 as Ptr<f64[]>);
+
+        let h = (e + geometriesLength * 4) * 2; // hashes after envelopes
+        const seen = dedup ? new Map<number, Geometry<P>[]>() : undefined;
+        if (seen) {
+            geos.hash_geoms(d * 4 as Ptr<GEOSGeometry[]>, geometriesLength, h * 4 as Ptr<u32[]>);
+        }
 
         B = geos.U32;
-        const geometriesLength = geojsons.length;
+        const F = geos.F64;
         const geosGeometries = Array<Geometry<P>>(geometriesLength);
         for (let i = 0; i < geometriesLength; i++) {
+            const geomPtr = B[ d++ ] as Ptr<GEOSGeometry>;
             const feature = geojsons[ i ];
-            geosGeometries[ i ] = new GeometryRef(
-                B[ d++ ] as Ptr<GEOSGeometry>,
+            let sameHash: Geometry<P>[] | undefined;
+            if (seen) {
+                sameHash = seen.get(B[ h ]);
+                const identical = sameHash?.find(g => geos.GEOSEqualsIdentical(g[ POINTER ], geomPtr));
+                if (identical) {
+                    geos.GEOSGeom_destroy(geomPtr);
+                    geosGeometries[ i ] = shareGeometry(identical, feature);
+                    e += 4;
+                    h++;
+                    continue;
+                }
+            }
+            const geometry = new GeometryRef(
+                geomPtr,
                 feature.geometry.type,
                 feature,
             ) as Geometry<P>;
+            geometry[ ENVELOPE ] = Number.isNaN(F[ e ]) ? null : envelopeSlot(F, e); // NaN for empty and curved geometries
+            if (seen) {
+                if (sameHash) {
+                    sameHash.push(geometry);
+                } else {
+                    seen.set(B[ h ], [ geometry ]);
+                }
+            }
+            e += 4;
+            h++;
+            geosGeometries[ i ] = geometry;
         }
         return geosGeometries;
     } finally {
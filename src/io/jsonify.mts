@@ -10,9 +10,10 @@
  *
  * A list of pointers of the GEOS geometries to jsonify is prepared in an
  * input buffer. The first 2 elements of this buffer are special:
- * - `buff[0]` -> JS side sets this to `0` if Wasm side changes it, it means
- *   that the input buffer was too small and a new temporary output buffer
- *   was created and the value of `buff[0]` is the pointer to it.
+ * - `buff[0]` -> JS side sets this to `0`, if Wasm side changes it, it means
+ *   that the buffer was too small for the output, nothing was written and
+ *   the value of `buff[0]` is the needed output size (in u32 units).
+ *   JS side then retries with a large enough buffer.
  * - `buff[1]` -> Wasm side will put here the pointer (starting index) to the
  *   buffer with the concatenated coordinates of all (Multi)Point geometries.
  *
@@ -22,7 +23,7 @@
 declare const THIS_FILE: symbol; // to omit ^ @file doc from the bundle
 
 import type { Position } from 'geojson';
-import type { Ptr, u32 } from '../core/types/WasmGEOS.mjs';
+import type { ReusableBuffer } from '../core/reusable-memory.mjs';
 import type { JSON_Feature, JSON_Geometry } from '../geom/types/JSON.mjs';
 import { POINTER } from '../core/symbols.mjs';
 import { CollectionElementsKeyMap, type CoordinateType, type Geometry, GeometryRef, GEOSGeometryTypeDecoder } from '../geom/Geometry.mjs';
@@ -220,31 +221,11 @@ const jsonifyGeom = (s: JsonifyState, o: OutputCoordsOptions, extended: boolean
  */
 export function jsonifyGeometry<T extends JSON_Geometry>(geometry: GeometryRef, layout?: CoordinateType, extended?: boolean): T {
     const o = CoordsOptionsMap[ layout || 'XYZ' ];
-    const buff = geos.buff;
-    let tmpOutBuffPtr: 0 | Ptr<u32>;
+    const [ buff, s ] = jsonifyGeoms([ geometry ]);
     try {
-        let B = geos.U32;
-        let b = buff.i4, b0 = b;
-        B[ b++ ] = 0;
-        B[ b++ ] = 1;
-        B[ b++ ] = geometry[ POINTER ];
-        B[ b ] = buff.l4 - 3; // buffAvailableL4
-
-        geos.jsonify_geoms(buff[ POINTER ]);
-
-        B = geos.U32;
-        const s: JsonifyState = { B, b, F: geos.F64, f: B[ b0 + 1 ] }; // f = buff[1]
-
-        tmpOutBuffPtr = B[ b0 ] as typeof tmpOutBuffPtr; // buff[0]
-        if (tmpOutBuffPtr) {
-            s.b = tmpOutBuffPtr / 4;
-        }
-
         return jsonifyGeom(s, o, extended) as T;
     } finally {
-        if (tmpOutBuffPtr!) {
-            geos.free(tmpOutBuffPtr);
-        }
+        buff.freeIfTmp();
     }
 }
 
@@ -286,29 +267,8 @@ export function jsonifyGeometry<T extends JSON_Geometry>(geometry: GeometryRef,
 export function jsonifyFeatures<P>(geometries: Geometry<P>[], layout?: CoordinateType, extended?: boolean): JSON_Feature<JSON_Geometry, P>[] {
     const o = CoordsOptionsMap[ layout || 'XYZ' ];
     const geometriesLength = geometries.length;
-    const buffNeededL4 = geometriesLength + 3;
-    const buff = geos.buffByL4(buffNeededL4);
-    let tmpOutBuffPtr: 0 | Ptr<u32>;
+    const [ buff, s ] = jsonifyGeoms(geometries);
     try {
-        let B = geos.U32;
-        let b = buff.i4, b0 = b;
-        B[ b++ ] = 0;
-        B[ b++ ] = geometriesLength;
-        for (const geometry of geometries) {
-            B[ b++ ] = geometry[ POINTER ];
-        }
-        B[ b ] = buff.l4 - buffNeededL4; // buffAvailableL4
-
-        geos.jsonify_geoms(buff[ POINTER ]);
-
-        B = geos.U32;
-        const s: JsonifyState = { B, b, F: geos.F64, f: B[ b0 + 1 ] }; // f = buff[1]
-
-        tmpOutBuffPtr = B[ b0 ] as typeof tmpOutBuffPtr; // buff[0]
-        if (tmpOutBuffPtr) {
-            s.b = tmpOutBuffPtr / 4;
-        }
-
         const features = Array<JSON_Feature<JSON_Geometry, P>>(geometriesLength);
         for (let i = 0; i < geometriesLength; i++) {
             const geometry = geometries[ i ];
@@ -317,13 +277,49 @@ export function jsonifyFeatures<P>(geometries: Geometry<P>[], layout?: Coordinat
         return features;
     } finally {
         buff.freeIfTmp();
-        if (tmpOutBuffPtr!) {
-            geos.free(tmpOutBuffPtr);
-        }
     }
 }
 
 
+/**
+ * Calls `jsonify_geoms`, retries with a buffer of the reported size when
+ * the output does not fit. The scratch buffer grows to the retried size,
+ * so subsequent calls of a similar size fit at once.
+ * The returned buffer has to be released with `freeIfTmp` after reading.
+ */
+const jsonifyGeoms = (geometries: GeometryRef[]): [ ReusableBuffer, JsonifyState ] => {
+    const headerL4 = geometries.length + 3; // [0, n, geometries, buffAvailableL4]
+    let buff = geos.buffAtLeastL4(headerL4);
+    try {
+        for (; ;) {
+            let B = geos.U32;
+            let b = buff.i4;
+            const b0 = b;
+            B[ b++ ] = 0;
+            B[ b++ ] = geometries.length;
+            for (const geometry of geometries) {
+                B[ b++ ] = geometry[ POINTER ];
+            }
+            B[ b ] = buff.l4 - headerL4; // buffAvailableL4
+
+            geos.jsonify_geoms(buff[ POINTER ]);
+
+            B = geos.U32;
+            const neededL4 = B[ b0 ]; // buff[0]
+            if (!neededL4) {
+                return [ buff, { B, b, F: geos.F64, f: B[ b0 + 1 ] } ]; // f = buff[1]
+            }
+            buff.freeIfTmp();
+            buff = geos.buff; // already released, nothing to free if the next line throws
+            buff = geos.buffByL4(headerL4 + neededL4 + 1); // +1 for F alignment
+        }
+    } catch (e) {
+        buff.freeIfTmp();
+        throw e;
+    }
+};
+
+
 export function feature<P>(f: GeometryRef<P>, g: JSON_Geometry): JSON_Feature<JSON_Geometry, P> {
     return { id: f.id, type: 'Feature', geometry: g, properties: (f.props ?? null) as P };
 }
@@ -1,6 +1,7 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import { POINTER } from '../core/symbols.mjs';
+import { MEMO, POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { pairwiseF64 } from '../core/pairwise.mjs';
 
 
 /**
@@ -21,7 +22,34 @@ import { geos } from '../core/geos.mjs';
  * const polyArea = area(poly); // 7
  */
 export function area(geometry: Geometry): number {
-    const f = geos.f1;
-    geos.GEOSArea(geometry[ POINTER ], f[ POINTER ]);
-    return f.get();
+    const m = geometry[ MEMO ] ||= {};
+    if (m.area === undefined) {
+        const f = geos.f1;
+        geos.GEOSArea(geometry[ POINTER ], f[ POINTER ]);
+        m.area = f.get();
+    }
+    return m.area;
+}
+
+
+/**
+ * Same as {@link area}, but calculates the areas of many geometries in
+ * a single Wasm call.
+ *
+ * Unlike {@link area}, empty geometries and geometries on which GEOS fails
+ * do not return 0 or throw, their area is `NaN`.
+ *
+ * @param geometries - The array of geometries
+ * @returns An array of areas, one per geometry
+ *
+ * @example #live
+ * const areas = areaMany([
+ *     polygon([ [ [ 3, 3 ], [ 9, 4 ], [ 5, 1 ], [ 3, 3 ] ] ]),
+ *     box([ 0, 0, 2, 2 ]),
+ *     point([ 3, 1 ]),
+ *     polygon([]),
+ * ]); // Float64Array [ 7, 4, 0, NaN ]
+ */
+export function areaMany(geometries: Geometry[]): Float64Array {
+    return pairwiseF64('area', geometries, null, { lenient: true });
 }
@@ -1,7 +1,8 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import { POINTER } from '../core/symbols.mjs';
+import { MEMO, POINTER } from '../core/symbols.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { geos } from '../core/geos.mjs';
+import { pairwiseF64 } from '../core/pairwise.mjs';
 
 
 /**
@@ -21,9 +22,37 @@ import { geos } from '../core/geos.mjs';
  * const polyExtent = bounds(poly); // [ 3, 1, 9, 4 ]
  */
 export function bounds(geometry: Geometry): [ xMin: number, yMin: number, xMax: number, yMax: number ] {
+    const m = geometry[ MEMO ] ||= {};
+    if (m.bounds) {
+        return [ ...m.bounds ]; // copy, the result is mutable
+    }
     const xMin = geos.f1, yMin = geos.f2, xMax = geos.f3, yMax = geos.f4;
     if (geos.GEOSGeom_getExtent(geometry[ POINTER ], xMin[ POINTER ], yMin[ POINTER ], xMax[ POINTER ], yMax[ POINTER ])) {
-        return [ xMin.get(), yMin.get(), xMax.get(), yMax.get() ];
+        m.bounds = [ xMin.get(), yMin.get(), xMax.get(), yMax.get() ];
+        return [ ...m.bounds ];
     }
     throw new GEOSError('Cannot calculate bounds of an empty geometry');
 }
+
+
+/**
+ * Same as {@link bounds}, but calculates the bounds of many geometries in
+ * a single Wasm call.
+ *
+ * Unlike {@link bounds}, empty geometries do not throw, their bounds are
+ * all `NaN`.
+ *
+ * @param geometries - The array of geometries
+ * @returns A flat array of `4 * geometries.length` numbers, where bounds of
+ * `i`-th geometry `[ xMin, yMin, xMax, yMax ]` start at index `4 * i`
+ *
+ * @example #live
+ * const extents = boundsMany([
+ *     point([ 3, 1 ]),
+ *     polygon([ [ [ 3, 3 ], [ 9, 4 ], [ 5, 1 ], [ 3, 3 ] ] ]),
+ *     point([]),
+ * ]); // Float64Array [ 3, 1, 3, 1, 3, 1, 9, 4, NaN, NaN, NaN, NaN ]
+ */
+export function boundsMany(geometries: Geometry[]): Float64Array {
+    return pairwiseF64('bounds', geometries, null, { width: 4 });
+}
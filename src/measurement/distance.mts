@@ -1,9 +1,11 @@
+import type { f64, GEOSGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { isEmpty } from '../predicates/isEmpty.mjs';
+import { type BatchOptions, pairwiseF64, throwCapturedError } from '../core/pairwise.mjs';
 
 
 /**
@@ -38,8 +40,9 @@ import { isEmpty } from '../predicates/isEmpty.mjs';
  */
 export function distance(a: Geometry | Prepared<Geometry>, b: Geometry): number {
     const f = geos.f1;
-    a[ P_POINTER ]
-        ? geos.GEOSPreparedDistance(a[ P_POINTER ], b[ POINTER ], f[ POINTER ])
+    const pPtr = preparedPtr(a);
+    pPtr
+        ? geos.GEOSPreparedDistance(pPtr, b[ POINTER ], f[ POINTER ])
         : geos.GEOSDistance(a[ POINTER ], b[ POINTER ], f[ POINTER ]);
     const dist = f.get();
     if (!dist && (isEmpty(a) || isEmpty(b))) {
@@ -47,3 +50,115 @@ export function distance(a: Geometry | Prepared<Geometry>, b: Geometry): number
     }
     return dist;
 }
+
+
+/**
+ * Same as {@link distance}, but computes the distances of many pairs of
+ * geometries in a single Wasm call.
+ *
+ * Arrays `a` and `b` are processed element-wise, `i`-th result is the
+ * distance between `a[ i ]` and `b[ i ]`.
+ * When either `a` or `b` is a single geometry, it is paired with each
+ * element of the other array; single [prepared]{@link prepare} geometry `a`
+ * is used as such.
+ *
+ * Unlike {@link distance}, pairs with an empty geometry do not throw,
+ * their distance is `NaN`.
+ *
+ * @param a - First geometry or array of first geometries
+ * @param b - Second geometry or array of second geometries
+ * @param options - Optional options object
+ * @returns An array of distances, one per pair
+ * @throws {GEOSError} when `a` and `b` are arrays of different lengths
+ * @throws {GEOSError} on unsupported geometry types (curved), unless
+ * `options.errors` is provided, then distance of such pairs is `NaN`
+ *
+ * @example #live
+ * const a = point([ 0, 0 ]);
+ * const bs = [ point([ 3, 4 ]), lineString([ [ 0, 1 ], [ 1, 0 ] ]), point([]) ];
+ * const dists = distanceMany(a, bs); // Float64Array [ 5, 0.7071067811865476, NaN ]
+ */
+export function distanceMany(a: Geometry | Prepared<Geometry> | Geometry[], b: Geometry | Geometry[], options?: BatchOptions): Float64Array {
+    return pairwiseF64('distance', a, b, options);
+}
+
+
+export interface DistanceMatrixOptions {
+
+    /**
+     * The maximum distance of interest.
+     *
+     * Pairs further apart than `maxDistance` are cut short with a cheaper
+     * distance-within test and get `Infinity` instead of the exact distance.
+     * @default Infinity
+     */
+    maxDistance?: number;
+
+    /**
+     * Whether to prepare the geometries for the duration of the call.
+     *
+     * Geometries of the side with more vertices in total are prepared, so
+     * that their indexes are reused against every geometry of the other side.
+     * Worth it for all but the smallest matrices.
+     * @default true
+     */
+    prepared?: boolean;
+
+}
+
+/**
+ * Computes the Cartesian distances between each of the geometries `as` and
+ * each of the geometries `bs` in a single Wasm call.
+ *
+ * Pairs with an empty geometry have distance `NaN`.
+ *
+ * @param as - Array of first geometries, rows of the matrix
+ * @param bs - Array of second geometries, columns of the matrix
+ * @param options - Optional options object
+ * @returns A flat, row-major array of `as.length * bs.length` distances,
+ * where the distance between `as[ i ]` and `bs[ j ]` is at index `i * bs.length + j`
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @see {@link distanceMany} computes distances of aligned pairs
+ *
+ * @example #live
+ * const origins = [ point([ 0, 0 ]), point([ 10, 0 ]) ];
+ * const destinations = [ point([ 3, 4 ]), point([ 10, 1 ]), point([ 100, 100 ]) ];
+ * const matrix = distanceMatrix(origins, destinations, { maxDistance: 50 });
+ * // Float64Array [ 5, 10.04987562112089, Infinity, 8.06225774829855, 1, Infinity ]
+ */
+export function distanceMatrix(as: Geometry[], bs: Geometry[], options?: DistanceMatrixOptions): Float64Array {
+    const na = as.length, nb = bs.length;
+    const outL4 = (na + nb + 1) & ~1; // 8-byte aligned start of `out`
+    // [as: u32 x na][bs: u32 x nb][out: f64 x (na * nb)]
+    const buff = geos.buffByL4(outL4 + na * nb * 2);
+    try {
+        const ptr = buff[ POINTER ];
+        let B = geos.U32, b = buff.i4;
+        for (const geometry of as) {
+            B[ b++ ] = geometry[ POINTER ];
+        }
+        for (const geometry of bs) {
+            B[ b++ ] = geometry[ POINTER ];
+        }
+        const outPtr = ptr + outL4 * 4 as Ptr<f64[]>;
+        let failed: number;
+        try {
+            failed = geos.distance_matrix(
+                ptr, na,
+                ptr + na * 4 as Ptr<GEOSGeometry[]>, nb,
+                options?.maxDistance ?? Infinity,
+                +(options?.prepared ?? true),
+                outPtr,
+            );
+        } finally {
+            geos.error_capture_end();
+        }
+        if (failed) {
+            throwCapturedError();
+        }
+        return geos.F64.slice(outPtr / 8, outPtr / 8 + na * nb);
+    } finally {
+        buff.freeIfTmp();
+    }
+}
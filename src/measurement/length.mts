@@ -1,6 +1,7 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import { POINTER } from '../core/symbols.mjs';
+import { MEMO, POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { pairwiseF64 } from '../core/pairwise.mjs';
 
 
 /**
@@ -22,7 +23,34 @@ import { geos } from '../core/geos.mjs';
  * const polyLength = length(poly); // 4.82842712474619 = Math.sqrt(2) * 2 + 2
  */
 export function length(geometry: Geometry): number {
-    const f = geos.f1;
-    geos.GEOSLength(geometry[ POINTER ], f[ POINTER ]);
-    return f.get();
+    const m = geometry[ MEMO ] ||= {};
+    if (m.length === undefined) {
+        const f = geos.f1;
+        geos.GEOSLength(geometry[ POINTER ], f[ POINTER ]);
+        m.length = f.get();
+    }
+    return m.length;
+}
+
+
+/**
+ * Same as {@link length}, but calculates the lengths of many geometries in
+ * a single Wasm call.
+ *
+ * Unlike {@link length}, empty geometries and geometries on which GEOS
+ * fails do not return 0 or throw, their length is `NaN`.
+ *
+ * @param geometries - The array of geometries
+ * @returns An array of lengths, one per geometry
+ *
+ * @example #live
+ * const lengths = lengthMany([
+ *     lineString([ [ 0, 0 ], [ 3, 4 ] ]),
+ *     box([ 0, 0, 2, 2 ]),
+ *     point([ 3, 1 ]),
+ *     lineString([]),
+ * ]); // Float64Array [ 5, 8, 0, NaN ]
+ */
+export function lengthMany(geometries: Geometry[]): Float64Array {
+    return pairwiseF64('length', geometries, null, { lenient: true });
 }
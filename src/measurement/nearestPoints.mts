@@ -1,6 +1,6 @@
 import type { Point } from '../geom/types/Point.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { type Geometry, GeometryRef } from '../geom/Geometry.mjs';
 import { isEmpty } from '../predicates/isEmpty.mjs';
@@ -35,8 +35,9 @@ import { geos } from '../core/geos.mjs';
  * const [ a_pt, b_pt ] = nearestPoints(a, b); // [ <POINT (0.6 0.8)>, <POINT (1 1)> ]
  */
 export function nearestPoints(a: Geometry | Prepared<Geometry>, b: Geometry): [ a: Point, b: Point ] {
-    const cs = a[ P_POINTER ]
-        ? geos.GEOSPreparedNearestPoints(a[ P_POINTER ], b[ POINTER ])
+    const pPtr = preparedPtr(a);
+    const cs = pPtr
+        ? geos.GEOSPreparedNearestPoints(pPtr, b[ POINTER ])
         : geos.GEOSNearestPoints(a[ POINTER ], b[ POINTER ]);
     if (cs) {
         const x = geos.f1, y = geos.f2;
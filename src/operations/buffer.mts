@@ -1,7 +1,8 @@
-import type { GEOSBufCapStyles, GEOSBufJoinStyles } from '../core/types/WasmGEOS.mjs';
+import type { GEOSBufCapStyles, GEOSBufferParams, GEOSBufJoinStyles, Ptr } from '../core/types/WasmGEOS.mjs';
 import type { Polygon } from '../geom/types/Polygon.mjs';
 import type { MultiPolygon } from '../geom/types/MultiPolygon.mjs';
 import { POINTER } from '../core/symbols.mjs';
+import { type BatchOptions, pairwiseGeometries } from '../core/pairwise.mjs';
 import { type Geometry, GeometryRef } from '../geom/Geometry.mjs';
 import { geos } from '../core/geos.mjs';
 
@@ -92,6 +93,40 @@ export interface BufferOptions {
  * const empty3 = buffer(point([ 0, 0 ]), 0); // 'POLYGON EMPTY'
  */
 export function buffer(geometry: Geometry, distance: number, options?: BufferOptions): Polygon | MultiPolygon {
+    const geomPtr = geos.GEOSBufferWithParams(geometry[ POINTER ], getBufferParams(options), distance);
+    return new GeometryRef(geomPtr) as Polygon | MultiPolygon;
+}
+
+
+/**
+ * Same as {@link buffer}, but buffers many geometries in a single Wasm call.
+ *
+ * All geometries are buffered by the same `distance` with the same options.
+ *
+ * @param geometries - The array of geometries to buffer
+ * @param distance - The buffer distance
+ * @param options - Optional buffer options
+ * @returns An array of new (multi)polygons, one per geometry; when
+ * `options.errors` is provided, failed geometries result in `null`
+ * @throws {GEOSError} when GEOS fails on any geometry and `options.errors` is not provided
+ *
+ * @example #live
+ * const pts = [ point([ 0, 0 ]), point([ 10, 0 ]), point([ 20, 0 ]) ];
+ * const circles = bufferMany(pts, 2, { quadrantSegments: 4 });
+ */
+export function bufferMany(geometries: Geometry[], distance: number, options?: BufferOptions): (Polygon | MultiPolygon)[];
+export function bufferMany(geometries: Geometry[], distance: number, options: BufferOptions & BatchOptions): (Polygon | MultiPolygon | null)[];
+export function bufferMany(geometries: Geometry[], distance: number, options?: BufferOptions & BatchOptions): (Polygon | MultiPolygon | null)[] {
+    return pairwiseGeometries('buffer', geometries, null, {
+        param: distance,
+        ptrParam: getBufferParams(options),
+        errors: options?.errors,
+    }) as (Polygon | MultiPolygon | null)[];
+}
+
+
+/** Returns buffer params for the options, params are cached and reused */
+const getBufferParams = (options: BufferOptions | undefined): Ptr<GEOSBufferParams> => {
     const cache = geos.b_p;
     const key = options
         ? [ options.quadrantSegments, options.endCapStyle, options.joinStyle, options.mitreLimit, options.singleSided ].join()
@@ -130,7 +165,5 @@ export function buffer(geometry: Geometry, distance: number, options?: BufferOpt
         }
         paramsPtr = cache[ key ] = ptr;
     }
-
-    const geomPtr = geos.GEOSBufferWithParams(geometry[ POINTER ], paramsPtr, distance);
-    return new GeometryRef(geomPtr) as Polygon | MultiPolygon;
-}
+    return paramsPtr;
+};
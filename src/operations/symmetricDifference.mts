@@ -1,4 +1,5 @@
 import type { PrecisionGridOptions } from './types/PrecisionGridOptions.mjs';
+import { type BatchOptions, pairwiseGeometries } from '../core/pairwise.mjs';
 import { POINTER } from '../core/symbols.mjs';
 import { type Geometry, GeometryRef } from '../geom/Geometry.mjs';
 import { geos } from '../core/geos.mjs';
@@ -27,3 +28,32 @@ export function symmetricDifference(a: Geometry, b: Geometry, options?: Precisio
         : geos.GEOSSymDifference(a[ POINTER ], b[ POINTER ]);
     return new GeometryRef(geomPtr) as Geometry;
 }
+
+
+/**
+ * Same as {@link symmetricDifference}, but computes the symmetric differences of many pairs of
+ * geometries in a single Wasm call.
+ *
+ * Arrays `a` and `b` are processed element-wise, `i`-th result is the
+ * symmetric difference of `a[ i ]` with `b[ i ]`.
+ * When either `a` or `b` is a single geometry, it is paired with each
+ * element of the other array.
+ *
+ * @param a - First geometry or array of first geometries
+ * @param b - Second geometry or array of second geometries
+ * @param options - Optional options object
+ * @returns An array of new geometries, one per pair; when `options.errors`
+ * is provided, failed pairs result in `null`
+ * @throws {GEOSError} when `a` and `b` are arrays of different lengths
+ * @throws {GEOSError} when GEOS fails on any pair and `options.errors` is not provided
+ *
+ * @example #live
+ * const as = [ box([ 0, 0, 2, 2 ]), box([ 5, 5, 7, 7 ]) ];
+ * const bs = [ box([ 1, 1, 3, 3 ]), box([ 6, 6, 8, 8 ]) ];
+ * const sDiffs = symmetricDifferenceMany(as, bs);
+ */
+export function symmetricDifferenceMany(a: Geometry | Geometry[], b: Geometry | Geometry[], options?: PrecisionGridOptions): Geometry[];
+export function symmetricDifferenceMany(a: Geometry | Geometry[], b: Geometry | Geometry[], options: PrecisionGridOptions & BatchOptions): (Geometry | null)[];
+export function symmetricDifferenceMany(a: Geometry | Geometry[], b: Geometry | Geometry[], options?: PrecisionGridOptions & BatchOptions): (Geometry | null)[] {
+    return pairwiseGeometries('symmetricDifference', a, b, { param: options?.gridSize ?? NaN, errors: options?.errors });
+}
@@ -0,0 +1,177 @@
+import { GeometryRef } from '../geom/Geometry.mjs';
+import { ARENA, P_FINALIZATION, P_POINTER, SCOPE } from '../core/symbols.mjs';
+import { destroyGeometries, detachGeometries } from '../geom/scope.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+export interface ArenaOptions {
+    /**
+     * Size of the arena region in bytes. Used only by the first
+     * {@link beginArena} call, the region is reused afterward.
+     * @default 67108864 (64MB)
+     */
+    capacity?: number;
+}
+
+export interface ArenaStats {
+    /** Size of the arena region in bytes */
+    capacity: number;
+    /** Bytes of the region used since {@link beginArena} */
+    used: number;
+    /** Number of allocations served from the region */
+    allocations: number;
+    /** Number of allocations that did not fit in the region and were served by the regular allocator */
+    fallbacks: number;
+}
+
+
+const CACHES = [ 't_r', 't_w', 'b_r', 'b_w', 'b_p', 'm_v' ] as const;
+
+/**
+ * State of the active arena, stored on the instance the arena belongs to
+ * @internal
+ */
+export interface ArenaState {
+    outerScope: GeometryRef[] | undefined;
+    created: GeometryRef[];
+    prepared: GeometryRef[];
+    cacheKeys: Record<typeof CACHES[number], string[]>;
+}
+
+
+/**
+ * For performance optimization.
+ * Starts a job arena: until {@link resetArena} is called, all Wasm memory
+ * allocations are served from a single preallocated region by bumping
+ * an offset, and freeing memory is a no-op. `resetArena` then discards
+ * everything at once, instead of freeing objects one by one.
+ *
+ * Useful for batch jobs that create many short-lived intermediate
+ * geometries, like "parse, overlay, serialize" loops.
+ *
+ * All geometries created while the arena is active become
+ * [detached]{@link GeometryRef#detached} on reset, results have to be
+ * serialized (for example with {@link toGeoJSON}) before the reset.
+ * Geometries created before the arena and [prepared]{@link prepare} while
+ * it is active lose their prepared indexes. Spatial indexes
+ * ({@link STRTree}, {@link PointGrid}) built while the arena is active
+ * must not be used after the reset.
+ *
+ * Available only in Wasm builds with `GEOS_JS_ARENA=ON`, see `cpp/INSTALL.md`.
+ *
+ * @param options - Optional arena options
+ * @param options.capacity - Size of the arena region in bytes
+ * @throws {GEOSError} when the Wasm build has no arena support
+ * @throws {GEOSError} when the arena is already active
+ * @throws {GEOSError} when the arena region cannot be allocated
+ *
+ * @see {@link resetArena} ends the arena
+ * @see {@link scope} frees intermediate geometries in regular builds
+ *
+ * @example
+ * const results = [];
+ * for (const batch of batches) {
+ *     beginArena({ capacity: 256 * 1024 * 1024 });
+ *     try {
+ *         const merged = unaryUnion(fromGeoJSON(batch));
+ *         results.push(toGeoJSON(merged));
+ *     } finally {
+ *         resetArena();
+ *     }
+ * }
+ */
+export function beginArena(options?: ArenaOptions): void {
+    if (!geos.arena_begin) {
+        throw new GEOSError('Arena is not available in this build');
+    }
+    if (geos.a_s) {
+        throw new GEOSError('Arena is already active');
+    }
+    const capacity = options?.capacity ?? 64 * 1024 * 1024;
+    if (!geos.arena_begin(capacity)) {
+        throw new GEOSError('Could not allocate arena');
+    }
+    const cacheKeys = {} as Record<typeof CACHES[number], string[]>;
+    for (const cache of CACHES) {
+        cacheKeys[ cache ] = Object.keys(geos[ cache ]);
+    }
+    geos.a_s = {
+        outerScope: GeometryRef[ SCOPE ],
+        created: GeometryRef[ SCOPE ] = [],
+        prepared: GeometryRef[ ARENA ] = [],
+        cacheKeys,
+    };
+}
+
+
+/**
+ * Ends the job arena started by {@link beginArena} and discards all the
+ * Wasm memory allocated while it was active.
+ *
+ * When some allocations did not fit in the arena region (`fallbacks > 0`),
+ * the geometries are destroyed one by one instead, so that the memory
+ * served by the regular allocator is not leaked. Size the arena so that
+ * this does not happen.
+ *
+ * @returns Arena usage statistics, collected before the reset
+ * @throws {GEOSError} when the arena is not active
+ *
+ * @see {@link beginArena} starts the arena
+ */
+export function resetArena(): ArenaStats {
+    const active = geos.a_s;
+    if (!active) {
+        throw new GEOSError('Arena is not active');
+    }
+    const { outerScope, created, prepared, cacheKeys } = active;
+    geos.a_s = undefined;
+    GeometryRef[ SCOPE ] = outerScope;
+    GeometryRef[ ARENA ] = undefined;
+
+    const s = geos.arena_stats!() / 8;
+    const F = geos.F64;
+    const stats: ArenaStats = {
+        capacity: F[ s ],
+        used: F[ s + 1 ],
+        allocations: F[ s + 2 ],
+        fallbacks: F[ s + 3 ],
+    };
+    const destroy = stats.fallbacks > 0;
+
+    // geometries created before the arena but prepared while it was active
+    const createdSet = new Set(created);
+    for (const geometry of prepared) {
+        const pPtr = geometry[ P_POINTER ];
+        if (pPtr && !geometry.detached && !createdSet.has(geometry)) {
+            GeometryRef[ P_FINALIZATION ](geometry).unregister(geometry);
+            delete geometry[ P_POINTER ];
+            geos.a_p?.forget(pPtr);
+            if (destroy) {
+                geos.GEOSPreparedGeom_destroy(pPtr);
+            }
+        }
+    }
+
+    const alive = created.filter(g => !g.detached);
+    if (destroy) {
+        destroyGeometries(alive);
+    } else {
+        detachGeometries(alive);
+    }
+
+    // readers, writers and params created while the arena was active
+    for (const cache of CACHES) {
+        const keep = new Set(cacheKeys[ cache ]);
+        const record = geos[ cache ];
+        for (const key in record) {
+            if (!keep.has(key)) {
+                delete record[ key ];
+            }
+        }
+    }
+
+    geos.s_b.trim(); // may have grown into the arena region
+    geos.arena_reset!();
+    return stats;
+}
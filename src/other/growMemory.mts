@@ -23,6 +23,8 @@ import { geos } from '../core/geos.mjs';
  * @param options.to - To how many bytes the memory will grow; target value
  * @returns The new size of the memory, in bytes
  *
+ * @see {@link memoryGrowthPolicy} sets how the memory grows on its own
+ *
  * @example grow memory by 512MB
  * growMemory({ by: 512 * 1024 * 1024 });
  *
@@ -44,6 +46,7 @@ export function growMemory(options: { by: number } | { to: number }): number {
     if (pagesToGrow > 0) {
         geos.memory.grow(pagesToGrow);
         geos.updateMemory();
+        geos.m_g.byteLength = geos.memory.buffer.byteLength; // manual growth, not counted by the growth policy
     }
     return geos.memory.buffer.byteLength;
 }
@@ -0,0 +1,46 @@
+import type { Ptr, u32 } from '../core/types/WasmGEOS.mjs';
+import type { Geometry } from '../geom/Geometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+/**
+ * Calculates structural hashes of the geometries.
+ *
+ * The hash covers geometry type, coordinate dimensions, structure and
+ * the exact coordinate values. Geometries that are [identical]{@link equalsIdentical}
+ * always have the same hash, different geometries usually have different
+ * hashes, so the hash can be used to quickly find duplicates.
+ *
+ * Hashes are not stable across library versions, do not persist them.
+ *
+ * @param geometries - The array of geometries
+ * @returns An array of hashes, one per geometry
+ *
+ * @see {@link equalsIdentical} to tell apart geometries with the same hash
+ *
+ * @example #live
+ * const [ a, b, c ] = hash([
+ *     lineString([ [ 0, 0 ], [ 1, 1 ] ]),
+ *     lineString([ [ 0, 0 ], [ 1, 1 ] ]),
+ *     lineString([ [ 1, 1 ], [ 0, 0 ] ]),
+ * ]);
+ * const ab = a === b; // true
+ * const ac = a === c; // false
+ */
+export function hash(geometries: Geometry[]): Uint32Array {
+    const n = geometries.length;
+    const buff = geos.buffByL4(n);
+    try {
+        const geomsPtr = buff[ POINTER ];
+        const B = geos.U32;
+        let b = buff.i4;
+        for (const geometry of geometries) {
+            B[ b++ ] = geometry[ POINTER ];
+        }
+        geos.hash_geoms(geomsPtr as Ptr<any>, n, geomsPtr as Ptr<u32[]>);
+        return geos.U32.slice(buff.i4, buff.i4 + n);
+    } finally {
+        buff.freeIfTmp();
+    }
+}
@@ -0,0 +1,88 @@
+import type { Ptr } from '../core/types/WasmGEOS.mjs';
+import type { Geometry } from '../geom/Geometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+export interface HeapStats {
+    /** Bytes of `WebAssembly.Memory` managed by the allocator */
+    heapSize: number;
+    /** Bytes in use by live allocations, including allocator overhead */
+    inUse: number;
+    /** Free bytes, including the memory not yet claimed by the allocator */
+    free: number;
+    /** Number of free chunks in the heap, grows with fragmentation */
+    freeChunks: number;
+    /** Lower bound of the largest free contiguous block */
+    largestFree: number;
+    /** Number of live allocations */
+    allocations: number;
+}
+
+
+/**
+ * For capacity planning and leak triage.
+ * Returns `mallinfo`-style statistics of the Wasm heap.
+ *
+ * Unlike `growMemory({ by: 0 })`, which reports the size of the
+ * `WebAssembly.Memory` that never shrinks, these stats tell apart live
+ * data from free space. Many free chunks with a small `largestFree`
+ * indicate fragmentation.
+ *
+ * Diagnostics feature, available only in builds with `GEOS_JS_MALLOC_HOOKS=ON`
+ * (or `GEOS_JS_ARENA=ON`), see `cpp/INSTALL.md`.
+ *
+ * @returns Heap statistics
+ * @throws {GEOSError} when the Wasm build has no heap stats support
+ *
+ * @see {@link byteSize} estimates the size of a single geometry
+ *
+ * @example
+ * const before = heapStats();
+ * const geometries = Array.from({ length: 1000 }, (_, i) => point([ i, i ]));
+ * const after = heapStats();
+ * const allocated = after.inUse - before.inUse;
+ */
+export function heapStats(): HeapStats {
+    if (!geos.heap_stats) {
+        throw new GEOSError('Heap stats are available only in builds with GEOS_JS_MALLOC_HOOKS=ON');
+    }
+    const s = geos.heap_stats() / 8;
+    const F = geos.F64;
+    return {
+        heapSize: F[ s ],
+        inUse: F[ s + 1 ],
+        free: F[ s + 2 ],
+        freeChunks: F[ s + 3 ],
+        largestFree: F[ s + 4 ],
+        allocations: F[ s + 5 ],
+    };
+}
+
+
+/**
+ * Estimates the memory footprint of the geometry, in bytes.
+ *
+ * Includes geometry objects of the whole geometry tree, their coordinate
+ * sequence buffers and arrays of child pointers. Does not include the
+ * allocator overhead, unused capacity of the buffers and
+ * [prepared]{@link prepare} indexes.
+ *
+ * @param geometry - The geometry
+ * @returns Estimated size in bytes
+ *
+ * @see {@link heapStats} reports the whole Wasm heap
+ *
+ * @example #live
+ * const a = lineString([ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ] ]);
+ * const b = lineString([ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ], [ 3, 1 ] ]);
+ * const isLarger = byteSize(b) > byteSize(a); // true
+ */
+export function byteSize(geometry: Geometry): number {
+    const g = geos.u1;
+    const size = geos.f1;
+    g.set(geometry[ POINTER ]);
+    geos.geoms_byte_size(g[ POINTER ] as Ptr<any>, 1, size[ POINTER ]);
+    return size.get();
+}
@@ -0,0 +1,199 @@
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+export interface MemoryGrowthOptions {
+
+    /**
+     * Minimal growth step in bytes, memory size is always a multiple of it.
+     * @default 16777216 (16MB)
+     */
+    step?: number;
+
+    /**
+     * Geometric growth factor, memory grows at least to `current * factor`.
+     * With the default `1` memory grows linearly, by `step` at a time.
+     * @default 1
+     */
+    factor?: number;
+
+    /**
+     * Memory size in bytes the policy never grows the memory beyond.
+     *
+     * This is not a hard limit. An allocation that needs more still grows
+     * the memory, by as much as it needs, which is reported as an overrun.
+     * The hard limit is set at build time with `GEOS_JS_MAXIMUM_MEMORY`
+     * (4GB by default, see `cpp/INSTALL.md`), beyond it allocations fail
+     * and the operation throws {@link GEOSError}.
+     * @default 4294967296 (4GB)
+     */
+    maximum?: number;
+
+    /**
+     * Called when an allocation grows the memory beyond `maximum`.
+     * It is called after the operation that caused the growth returns,
+     * never from within it.
+     */
+    onOverrun?: (byteLength: number) => void;
+
+    /**
+     * Soft memory limit in bytes, `onWarning` is called once when the
+     * memory grows beyond it.
+     * @default Infinity
+     */
+    warning?: number;
+
+    /**
+     * Called once when the memory grows beyond `warning`.
+     * It is called after the operation that caused the growth returns,
+     * never from within it.
+     */
+    onWarning?: (byteLength: number) => void;
+
+}
+
+export interface MemoryGrowthStats {
+    /** Number of memory growths */
+    count: number;
+    /** Time spent in growth handling, in milliseconds */
+    time: number;
+    /** Total number of bytes added by the growths */
+    bytes: number;
+    /** Number of growths beyond the policy `maximum` */
+    overruns: number;
+}
+
+
+/**
+ * For performance optimization.
+ * Sets the policy of the Wasm memory growth.
+ *
+ * When an allocation does not fit in the Wasm memory, the memory grows
+ * and the views of the memory must be recreated. By default, the memory
+ * grows linearly in 16MB steps, so loading a lot of data at once grows
+ * memory many times. Geometric growth (`factor > 1`) needs fewer steps
+ * at the cost of more unused memory.
+ *
+ * The policy is reset with each [initialization]{@link initialize}, the
+ * growth statistics are kept when the policy changes.
+ *
+ * @param options - Growth policy options, or `false` to restore the
+ * default linear policy
+ * @throws {GEOSError} on invalid options
+ *
+ * @see {@link memoryGrowthStats} reports the growth statistics
+ * @see {@link growMemory} reserves memory in advance
+ *
+ * @example
+ * memoryGrowthPolicy({
+ *     factor: 1.5,
+ *     maximum: 2 * 1024 * 1024 * 1024,
+ *     onOverrun: (byteLength) => console.error(`Wasm memory over budget at ${byteLength} bytes`),
+ *     warning: 1024 * 1024 * 1024,
+ *     onWarning: (byteLength) => console.warn(`Wasm memory at ${byteLength} bytes`),
+ * });
+ */
+export function memoryGrowthPolicy(options: MemoryGrowthOptions | false): void {
+    const { byteLength, stats } = geos.m_g;
+    geos.m_g = new MemoryGrowthPolicy(options || {}, byteLength, stats);
+}
+
+
+/**
+ * Returns statistics of the Wasm memory growths since the initialization.
+ *
+ * @returns Growth statistics
+ *
+ * @see {@link memoryGrowthPolicy} sets the growth policy
+ *
+ * @example
+ * const { count, time, bytes, overruns } = memoryGrowthStats();
+ */
+export function memoryGrowthStats(): MemoryGrowthStats {
+    return { ...geos.m_g.stats };
+}
+
+
+/**
+ * Handles memory growth according to the policy.
+ * @internal
+ */
+export class MemoryGrowthPolicy {
+
+    /** In wasm pages */
+    readonly step: number;
+    readonly factor: number;
+    /** In wasm pages */
+    readonly maximum: number;
+    readonly onOverrun?: (byteLength: number) => void;
+    /** Set to `Infinity` once the warning is reported */
+    warning: number;
+    readonly onWarning?: (byteLength: number) => void;
+
+    readonly stats: MemoryGrowthStats;
+    /** Memory size after the last growth, manual growths included */
+    byteLength: number;
+
+    constructor(options: MemoryGrowthOptions, byteLength: number, stats: MemoryGrowthStats = { count: 0, time: 0, bytes: 0, overruns: 0 }) {
+        const { step = 16 * 1024 * 1024, factor = 1, maximum = 4 * 1024 * 1024 * 1024, onOverrun, warning = Infinity, onWarning } = options;
+        if (!(step >= 65536 && factor >= 1 && maximum >= step)) {
+            throw new GEOSError('Invalid memory growth options');
+        }
+        this.step = Math.ceil(step / 65536); // 65536 = 64 * 1024 = 64KB = wasm page size
+        this.factor = factor;
+        this.maximum = Math.min(65535, Math.floor(maximum / 65536)); // 65535 pages = 4GB - 64KB = max page count
+        this.onOverrun = onOverrun;
+        this.warning = warning;
+        this.onWarning = onWarning;
+        this.byteLength = byteLength;
+        this.stats = stats;
+    }
+
+    /**
+     * Called after Wasm has grown the memory on its own to fit an allocation.
+     * Runs inside the Wasm call that allocates, so it must not throw, user
+     * callbacks are deferred until the call returns.
+     * @param owner - The instance whose memory has grown, not necessarily the global `geos`
+     */
+    onGrowth(owner: Pick<typeof geos, 'memory' | 'updateMemory'>): void {
+        const t0 = performance.now();
+        const { memory } = owner;
+        const currentPageCount = memory.buffer.byteLength / 65536;
+        const { step } = this;
+        let targetPageCount = currentPageCount + step - (currentPageCount % step);
+        if (this.factor > 1) {
+            targetPageCount = Math.max(targetPageCount, Math.ceil(currentPageCount * this.factor / step) * step);
+        }
+        targetPageCount = Math.min(targetPageCount, this.maximum);
+        if (targetPageCount > currentPageCount) {
+            try {
+                memory.grow(targetPageCount - currentPageCount);
+            } catch {
+                // beyond the build time limit, Wasm still grows on demand up to it
+            }
+        }
+        owner.updateMemory();
+
+        const { stats } = this;
+        const byteLength = memory.buffer.byteLength;
+        stats.count++;
+        stats.bytes += byteLength - this.byteLength;
+        this.byteLength = byteLength;
+        if (currentPageCount > this.maximum) {
+            stats.overruns++;
+            const { onOverrun } = this;
+            if (onOverrun) {
+                queueMicrotask(() => onOverrun(byteLength));
+            }
+        }
+        if (byteLength > this.warning) {
+            this.warning = Infinity;
+            const { onWarning } = this;
+            if (onWarning) {
+                queueMicrotask(() => onWarning(byteLength));
+            }
+        }
+        stats.time += performance.now() - t0;
+    }
+
+}
@@ -0,0 +1,229 @@
+import { GeometryRef } from '../geom/Geometry.mjs';
+import { AutoPrepareCache } from '../geom/PreparedGeometry.mjs';
+import { ARENA, SCOPE } from '../core/symbols.mjs';
+import { destroyGeometries, detachGeometries } from '../geom/scope.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { activate, geos, instantiateDetached } from '../core/geos.mjs';
+
+
+export interface PoolOptions {
+
+    /**
+     * Number of GEOS instances in the pool.
+     * @default 2
+     */
+    size?: number;
+
+    /**
+     * Number of runs after which an instance is recycled - its memory is
+     * reset to the state right after the initialization.
+     * With the default `Infinity` instances are recycled only by
+     * {@link GEOSPool#recycle}.
+     * @default Infinity
+     */
+    recycleAfter?: number;
+
+}
+
+export interface PoolStats {
+    /** Number of instances in the pool */
+    size: number;
+    /** Number of runs */
+    runs: number;
+    /** Number of instance recycles */
+    recycles: number;
+    /** Time spent recycling instances, in milliseconds */
+    recycleTime: number;
+}
+
+
+/**
+ * For long-running services.
+ * Creates a pool of isolated GEOS instances from one compiled module.
+ *
+ * Each instance has its own Wasm memory. Work is routed to the instances
+ * with {@link GEOSPool#run}, and an instance is recycled by restoring its
+ * memory from a snapshot taken right after its initialization, which
+ * removes any heap fragmentation accumulated over time. Neither creating
+ * the instances nor recycling them recompiles the module.
+ *
+ * The pool is independent of the instance [initialized]{@link initialize}
+ * globally, which does not have to be initialized at all.
+ *
+ * @param module - Compiled `geos.js` module, as returned by {@link initialize}
+ * @param options - Optional pool options
+ * @param options.size - Number of GEOS instances in the pool
+ * @param options.recycleAfter - Number of runs after which an instance is recycled
+ * @returns A Promise that resolves with the pool
+ * @throws {GEOSError} on invalid options
+ *
+ * @example
+ * const module = await WebAssembly.compileStreaming(fetch('geos_js.wasm'));
+ * const pool = await createPool(module, { size: 4, recycleAfter: 10_000 });
+ * app.post('/union', (req, res) => {
+ *     res.json(pool.run(() => toGeoJSON(unaryUnion(fromGeoJSON(req.body)))));
+ * });
+ */
+export async function createPool(module: WebAssembly.Module, options?: PoolOptions): Promise<GEOSPool> {
+    const { size = 2, recycleAfter = Infinity } = options || {};
+    if (!(size >= 1 && Number.isInteger(size) && recycleAfter >= 1)) {
+        throw new GEOSError('Invalid pool options');
+    }
+    const members = await Promise.all(Array.from({ length: size }, async (): Promise<PoolMember> => {
+        const instance = await instantiateDetached(module);
+        return { instance, snapshot: takeSnapshot(instance), runs: 0 };
+    }));
+    return new GEOSPool(members, recycleAfter);
+}
+
+
+type GEOS = typeof geos;
+
+interface PoolMember {
+    readonly instance: GEOS;
+    /** Memory right after the initialization, without the trailing zeros */
+    readonly snapshot: Uint8Array;
+    /** Runs since the last recycle */
+    runs: number;
+}
+
+/**
+ * Pool of isolated GEOS instances, see {@link createPool}.
+ */
+export class GEOSPool {
+
+    private readonly members: PoolMember[];
+    private readonly recycleAfter: number;
+    private next: number = 0;
+    private readonly s: PoolStats;
+
+    /** @internal */
+    constructor(members: PoolMember[], recycleAfter: number) {
+        this.members = members;
+        this.recycleAfter = recycleAfter;
+        this.s = { size: members.length, runs: 0, recycles: 0, recycleTime: 0 };
+    }
+
+    /**
+     * Runs `fn` on the next instance of the pool, in round-robin order.
+     *
+     * While `fn` runs, all `geos.js` functions operate on that instance.
+     * All geometries created during the call are freed when `fn` returns
+     * or throws, results have to be serialized (for example with
+     * {@link toGeoJSON}) inside `fn`. Geometries created outside `fn`
+     * belong to another instance and must not be used inside it, and
+     * spatial indexes ({@link STRTree}, {@link PointGrid}) built inside `fn`
+     * must be freed before it returns.
+     *
+     * `fn` has to be synchronous, and runs on the same instance cannot be nested.
+     *
+     * @template T - The type of the `fn` result
+     * @param fn - Function to run
+     * @returns The result of `fn`
+     * @throws {GEOSError} when called from a run on the same instance
+     *
+     * @example
+     * const a = pool.run(() => area(fromWKT('POLYGON ((0 0, 1 0, 0 1, 0 0))'))); // 0.5
+     */
+    run<T>(fn: () => T): T {
+        const { members } = this;
+        const member = members[ this.next ];
+        const { instance } = member;
+        if (instance.p_r) {
+            throw new GEOSError('Pool runs cannot be nested');
+        }
+        this.next = (this.next + 1) % members.length;
+
+        const outerGeos = activate(instance);
+        const outerScope = GeometryRef[ SCOPE ];
+        const outerArena = GeometryRef[ ARENA ];
+        const created: GeometryRef[] = GeometryRef[ SCOPE ] = [];
+        GeometryRef[ ARENA ] = undefined;
+        instance.p_r = true;
+        try {
+            return fn();
+        } finally {
+            instance.p_r = false;
+            GeometryRef[ SCOPE ] = outerScope;
+            GeometryRef[ ARENA ] = outerArena;
+            this.s.runs++;
+            const alive = created.filter(g => !g.detached);
+            if (++member.runs >= this.recycleAfter) {
+                detachGeometries(alive); // no need to free, the memory is reset anyway
+                this.reset(member);
+            } else {
+                destroyGeometries(alive);
+            }
+            activate(outerGeos);
+        }
+    }
+
+    /**
+     * Recycles all the instances of the pool - resets their memory to the
+     * state right after the initialization.
+     *
+     * Policies set inside the runs, like {@link memoryGrowthPolicy}, are kept.
+     * The `WebAssembly.Memory` of the instances does not shrink.
+     *
+     * @throws {GEOSError} when called from a pool run
+     */
+    recycle(): void {
+        if (this.members.some(member => member.instance.p_r)) {
+            throw new GEOSError('Pool cannot be recycled from a pool run');
+        }
+        for (const member of this.members) {
+            this.reset(member);
+        }
+    }
+
+    /**
+     * Returns statistics of the pool since its creation.
+     *
+     * @returns Pool statistics
+     */
+    stats(): PoolStats {
+        return { ...this.s };
+    }
+
+    private reset(member: PoolMember): void {
+        const t0 = performance.now();
+        const { instance, snapshot } = member;
+
+        // functions added to the table after the initialization
+        for (const fn of Array.from(instance.functionsInTableMap.keys())) {
+            if (fn !== instance.onGEOSError) {
+                instance.removeFunction(fn);
+            }
+        }
+
+        instance.updateMemory(); // could have grown since the last run
+        instance.U8.set(snapshot);
+        instance.U8.fill(0, snapshot.length);
+
+        // js side pointers into the reset memory
+        instance.s_b.drop();
+        instance.t_r = {};
+        instance.t_w = {};
+        instance.b_r = {};
+        instance.b_w = {};
+        instance.b_p = {};
+        instance.m_v = {};
+        instance.a_s = undefined; // arena left active by a run, reset with the memory
+        if (instance.a_p) {
+            instance.a_p = new AutoPrepareCache(instance.a_p);
+        }
+
+        member.runs = 0;
+        this.s.recycles++;
+        this.s.recycleTime += performance.now() - t0;
+    }
+
+}
+
+
+const takeSnapshot = (instance: GEOS): Uint8Array => {
+    const { U32 } = instance;
+    let l4 = U32.length;
+    while (l4 && !U32[ l4 - 1 ]) l4--;
+    return instance.U8.slice(0, l4 * 4);
+};
@@ -0,0 +1,74 @@
+import type { ScratchBufferStats } from '../core/reusable-memory.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+export type { ScratchBufferStats };
+
+export interface ScratchBufferOptions {
+
+    /**
+     * Maximum size of the scratch buffer in bytes, larger requests are
+     * served by temporary buffers freed right after the call.
+     * @default 16777216 (16MB)
+     */
+    maximum?: number;
+
+    /**
+     * Time in milliseconds after the last use, after which the scratch
+     * buffer is freed. With the default `Infinity` it is kept until
+     * the next policy change.
+     * @default Infinity
+     */
+    idle?: number;
+
+}
+
+
+/**
+ * For performance optimization.
+ * Sets the policy of the scratch buffer used to exchange data with Wasm.
+ *
+ * Data of calls that do not fit in the default 4KB buffer, like geosify
+ * of many features, jsonify of large geometries or large WKB imports, is
+ * exchanged through a scratch buffer, that grows to the largest request
+ * so far, instead of allocating and freeing a temporary buffer on every call.
+ *
+ * Setting the policy frees the current scratch buffer.
+ *
+ * @param options - Scratch buffer options
+ * @throws {GEOSError} on invalid options
+ *
+ * @see {@link scratchBufferStats} reports the scratch buffer statistics
+ *
+ * @example keep at most 64MB, release after 10 seconds of inactivity
+ * scratchBufferPolicy({ maximum: 64 * 1024 * 1024, idle: 10_000 });
+ *
+ * @example disable the scratch buffer, every large call allocates a temporary buffer
+ * scratchBufferPolicy({ maximum: 0 });
+ */
+export function scratchBufferPolicy(options: ScratchBufferOptions): void {
+    const { maximum = 16 * 1024 * 1024, idle = Infinity } = options;
+    if (!(maximum >= 0 && idle >= 0)) {
+        throw new GEOSError('Invalid scratch buffer options');
+    }
+    const { s_b } = geos;
+    s_b.maximum = maximum;
+    s_b.idle = idle;
+    s_b.trim();
+}
+
+
+/**
+ * Returns statistics of the scratch buffer since the initialization.
+ *
+ * @returns Scratch buffer statistics
+ *
+ * @see {@link scratchBufferPolicy} sets the scratch buffer policy
+ *
+ * @example
+ * const { size, resizes, tmpAllocations, decays } = scratchBufferStats();
+ */
+export function scratchBufferStats(): ScratchBufferStats {
+    return { ...geos.s_b.stats };
+}
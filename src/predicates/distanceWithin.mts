@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { type BatchOptions, pairwiseU8 } from '../core/pairwise.mjs';
+import { envelopesFurtherThan } from '../geom/envelope.mjs';
 
 
 /**
@@ -31,9 +33,43 @@ import { geos } from '../core/geos.mjs';
  * const dwithin_71 = distanceWithin(a, b, 7.1); // true
  */
 export function distanceWithin(a: Geometry | Prepared<Geometry>, b: Geometry, maxDistance: number): boolean {
+    if (envelopesFurtherThan(a, b, maxDistance)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedDistanceWithin(a[ P_POINTER ], b[ POINTER ], maxDistance)
+        pPtr
+            ? geos.GEOSPreparedDistanceWithin(pPtr, b[ POINTER ], maxDistance)
             : geos.GEOSDistanceWithin(a[ POINTER ], b[ POINTER ], maxDistance),
     );
 }
+
+
+/**
+ * Same as {@link distanceWithin}, but tests many pairs of geometries in
+ * a single Wasm call.
+ *
+ * Arrays `a` and `b` are processed element-wise, `i`-th result tells
+ * whether `a[ i ]` and `b[ i ]` are within `maxDistance` of each other.
+ * When either `a` or `b` is a single geometry, it is paired with each
+ * element of the other array; single [prepared]{@link prepare} geometry `a`
+ * is used as such.
+ *
+ * @param a - First geometry or array of first geometries
+ * @param b - Second geometry or array of second geometries
+ * @param maxDistance - The maximum distance
+ * @param options - Optional options object
+ * @returns An array where `i`-th element is `1` when the `i`-th pair is
+ * within `maxDistance`, and `0` otherwise
+ * @throws {GEOSError} when `a` and `b` are arrays of different lengths
+ * @throws {GEOSError} on unsupported geometry types (curved), unless
+ * `options.errors` is provided
+ *
+ * @example #live
+ * const a = point([ 0, 0 ]);
+ * const bs = [ point([ 3, 4 ]), point([ 1, 1 ]), point([ 0, 2 ]) ];
+ * const within = distanceWithinMany(a, bs, 2); // Uint8Array [ 0, 1, 1 ]
+ */
+export function distanceWithinMany(a: Geometry | Prepared<Geometry> | Geometry[], b: Geometry | Geometry[], maxDistance: number, options?: BatchOptions): Uint8Array {
+    return pairwiseU8('distanceWithin', a, b, { param: maxDistance, errors: options?.errors });
+}
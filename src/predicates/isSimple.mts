@@ -1,5 +1,5 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import { POINTER } from '../core/symbols.mjs';
+import { MEMO, POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
 
 
@@ -45,5 +45,6 @@ import { geos } from '../core/geos.mjs';
  * const d_simple = isSimple(d); // true - ring
  */
 export function isSimple(geometry: Geometry): boolean {
-    return Boolean(geos.GEOSisSimple(geometry[ POINTER ]));
+    const m = geometry[ MEMO ] ||= {};
+    return m.isSimple ??= Boolean(geos.GEOSisSimple(geometry[ POINTER ]));
 }
@@ -1,7 +1,7 @@
 import type { Point as GeoJSON_Point } from 'geojson';
 import type { GEOSGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
 import type { OutPtr } from '../core/reusable-memory.mjs';
-import { POINTER } from '../core/symbols.mjs';
+import { MEMO, POINTER } from '../core/symbols.mjs';
 import { type Geometry, GeometryRef } from '../geom/Geometry.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { jsonifyGeometry } from '../io/jsonify.mjs';
@@ -87,7 +87,9 @@ export interface IsValidOptions {
  * const poly_valid2 = isValid(poly, { isInvertedRingValid: true }); // true
  */
 export function isValid(geometry: Geometry, options?: IsValidOptions): boolean {
-    return Boolean(geos.GEOSisValidDetail(geometry[ POINTER ], options?.isInvertedRingValid ? 1 : 0, 0 as Ptr<string[]>, 0 as Ptr<GEOSGeometry[]>));
+    const m = geometry[ MEMO ] ||= {};
+    const key = options?.isInvertedRingValid ? 'isValidIR' : 'isValid';
+    return m[ key ] ??= Boolean(geos.GEOSisValidDetail(geometry[ POINTER ], options?.isInvertedRingValid ? 1 : 0, 0 as Ptr<string[]>, 0 as Ptr<GEOSGeometry[]>));
 }
 
 
@@ -119,9 +121,14 @@ export function isValid(geometry: Geometry, options?: IsValidOptions): boolean {
  * // TopologyValidationError { message: 'Self-intersection', location: [ 0.5, 0.5 ] }
  */
 export function isValidOrThrow(geometry: Geometry, options?: IsValidOptions): void {
+    const m = geometry[ MEMO ] ||= {};
+    const key = options?.isInvertedRingValid ? 'isValidIR' : 'isValid';
+    if (m[ key ]) {
+        return;
+    }
     const r = geos.u1 as OutPtr<string[]>;
     const l = geos.u2 as OutPtr<GEOSGeometry[]>;
-    const isValid = geos.GEOSisValidDetail(geometry[ POINTER ], options?.isInvertedRingValid ? 1 : 0, r[ POINTER ], l[ POINTER ]);
+    const isValid = m[ key ] = Boolean(geos.GEOSisValidDetail(geometry[ POINTER ], options?.isInvertedRingValid ? 1 : 0, r[ POINTER ], l[ POINTER ]));
     if (!isValid) {
         const reasonPtr = r.get();
         const reason = geos.decodeString(reasonPtr);
@@ -0,0 +1,239 @@
+import type { Ptr, u32 } from '../core/types/WasmGEOS.mjs';
+import type { PointGrid } from '../core/types/WasmOther.mjs';
+import type { OutPtr } from '../core/reusable-memory.mjs';
+import { CLEANUP, FINALIZATION, OWNER, POINTER } from '../core/symbols.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+import { readIndices } from './STRTree.mjs';
+
+
+export interface PointGridOptions {
+
+    /**
+     * The size of a single (square) grid cell.\
+     * Best performance is usually achieved when a cell holds a few points
+     * and when the typical query box/radius covers a few cells.
+     * When omitted, cell size is picked to hold ~4 points per cell.
+     * Too small values are increased to keep the number of cells in
+     * proportion to the number of points.
+     */
+    cellSize?: number;
+
+}
+
+/**
+ * Constructs a uniform grid spatial index over 2D points.
+ *
+ * Unlike {@link strTreeIndex}, the grid is built directly from the flat
+ * array of coordinates, no point geometries have to be created.
+ * Points are stored in the cell-sorted order, so that points which are close
+ * to each other are also close in memory.
+ *
+ * The index is query-only; once constructed, points cannot be added or
+ * removed from the index.
+ * Points with non-finite coordinates are ignored during indexing and will
+ * never be returned by queries.
+ *
+ * All queries return indices of the points in the input array, see
+ * {@link PointGridRef#queryBBox} for the `out` array semantic.
+ *
+ * @param coords - The flat array of point coordinates `[ x1, y1, x2, y2, ... ]`
+ * @param options - Optional options object
+ * @returns A new {@link PointGridRef} instance
+ * @throws {GEOSError} when `coords.length` is odd
+ * @throws {GEOSError} when `options.cellSize` is not a positive number
+ *
+ * @example #live
+ * const coords = new Float64Array([
+ *     0, 0, 1, 0, 2, 0,
+ *     0, 1, 1, 1, 2, 1,
+ *     0, 2, 1, 2, 2, 2,
+ * ]);
+ * const grid = pointGridIndex(coords);
+ *
+ * const inBox = grid.queryBBox(0.5, 0.5, 2, 2);
+ * // Uint32Array [ 4, 5, 7, 8 ] (in any order)
+ *
+ * const inRadius = grid.queryRadius(0, 0, 1);
+ * // Uint32Array [ 0, 1, 3 ] (in any order)
+ *
+ * const nearest = grid.nearest(1.9, 1.8, 2);
+ * // Uint32Array [ 8, 5 ]
+ */
+export function pointGridIndex(coords: Float64Array, options?: PointGridOptions): PointGridRef {
+    const f64Length = coords.length;
+    if (f64Length % 2) {
+        throw new GEOSError('Coordinates array length must be a multiple of 2');
+    }
+    const cellSize = options?.cellSize;
+    if (cellSize !== undefined && !(cellSize > 0 && cellSize < Infinity)) {
+        throw new GEOSError('Cell size must be a positive number');
+    }
+
+    const n = f64Length / 2;
+    const buff = geos.buffByL(f64Length * 8);
+    try {
+        geos.F64.set(coords, buff[ POINTER ] / 8);
+        const gridPtr = geos.PointGrid_create(buff[ POINTER ], n, cellSize ?? 0);
+        return new PointGridRef(gridPtr, n);
+    } finally {
+        buff.freeIfTmp();
+    }
+}
+
+
+/**
+ * Class representing a uniform grid point index that exists in the Wasm
+ * memory.
+ *
+ * To create new index use {@link pointGridIndex} function.
+ */
+export class PointGridRef {
+
+    /**
+     * The number of points in the input array, including the ignored ones.
+     */
+    readonly size: number;
+
+    /**
+     * Object becomes detached when manually [freed]{@link PointGridRef#free}.
+     * Detached objects are no longer valid and should not be used.
+     */
+    detached?: boolean;
+
+    /**
+     * Returns indices of all points that are inside the given box,
+     * boundary included.
+     *
+     * When `out` array is provided, indices are written into it and the
+     * number of matches is returned instead, so that repeated queries do not
+     * allocate anything. When `out` is too short, only the first
+     * `out.length` indices are written; compare the returned count with
+     * `out.length` to detect that.
+     *
+     * @param xMin - The minimum x-coordinate of the query box
+     * @param yMin - The minimum y-coordinate of the query box
+     * @param xMax - The maximum x-coordinate of the query box
+     * @param yMax - The maximum y-coordinate of the query box
+     * @param out - Optional array to write the indices into
+     * @returns A new array of indices, or the number of matches when `out`
+     * is provided
+     *
+     * @example #live
+     * const grid = pointGridIndex(new Float64Array([ 0, 0, 5, 5, 10, 10 ]));
+     * const matches = grid.queryBBox(-1, -1, 5, 5);
+     * // Uint32Array [ 0, 1 ]
+     *
+     * const out = new Uint32Array(grid.size); // allocated once
+     * const n = grid.queryBBox(6, 6, 11, 11, out);
+     * // n = 1, out = Uint32Array [ 2, 0, 0 ]
+     */
+    queryBBox(xMin: number, yMin: number, xMax: number, yMax: number): Uint32Array;
+    queryBBox(xMin: number, yMin: number, xMax: number, yMax: number, out: Uint32Array): number;
+    queryBBox(xMin: number, yMin: number, xMax: number, yMax: number, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.PointGrid_queryBBox(this[ POINTER ], xMin, yMin, xMax, yMax, l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
+    }
+
+    /**
+     * Returns indices of all points whose Cartesian distance to the given
+     * point is less than or equal to `radius`.
+     *
+     * See {@link PointGridRef#queryBBox} for the `out` array semantic.
+     *
+     * @param x - The x-coordinate of the query point
+     * @param y - The y-coordinate of the query point
+     * @param radius - The search radius
+     * @param out - Optional array to write the indices into
+     * @returns A new array of indices, or the number of matches when `out`
+     * is provided
+     *
+     * @example #live
+     * const grid = pointGridIndex(new Float64Array([ 0, 0, 3, 4, 4, 4 ]));
+     * const matches = grid.queryRadius(0, 0, 5);
+     * // Uint32Array [ 0, 1 ]
+     */
+    queryRadius(x: number, y: number, radius: number): Uint32Array;
+    queryRadius(x: number, y: number, radius: number, out: Uint32Array): number;
+    queryRadius(x: number, y: number, radius: number, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.PointGrid_queryRadius(this[ POINTER ], x, y, radius, l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
+    }
+
+    /**
+     * Returns indices of `k` points nearest to the given point, sorted by
+     * their distance, the nearest first.
+     * When two points are equally distant, the order between them is
+     * unspecified.
+     *
+     * See {@link PointGridRef#queryBBox} for the `out` array semantic.
+     *
+     * @param x - The x-coordinate of the query point
+     * @param y - The y-coordinate of the query point
+     * @param k - The number of neighbors to find
+     * @param out - Optional array to write the indices into
+     * @returns A new array of at most `k` indices, or the number of matches
+     * when `out` is provided
+     *
+     * @example #live
+     * const grid = pointGridIndex(new Float64Array([ 0, 0, 3, 4, 4, 4 ]));
+     * const nearest = grid.nearest(5, 5, 2);
+     * // Uint32Array [ 2, 1 ]
+     */
+    nearest(x: number, y: number, k?: number): Uint32Array;
+    nearest(x: number, y: number, k: number, out: Uint32Array): number;
+    nearest(x: number, y: number, k = 1, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.PointGrid_nearest(this[ POINTER ], x, y, k, l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
+    }
+
+    /**
+     * Frees the Wasm memory allocated for the grid object.
+     *
+     * This method exists as a backup for those who find [`FinalizationRegistry`]{@link https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/FinalizationRegistry}
+     * unreliable and want a way to free the memory manually.
+     *
+     * Manually freed object is marked as [detached]{@link PointGridRef#detached}.
+     */
+    free(): void {
+        PointGridRef[ FINALIZATION ](this).unregister(this);
+        PointGridRef[ CLEANUP ](this[ POINTER ], this[ OWNER ]);
+        this.detached = true;
+    }
+
+    /** @internal */
+    [ POINTER ]: Ptr<PointGrid>;
+
+    /**
+     * The instance that owns the Wasm object, the active `geos` at the creation
+     * @internal
+     */
+    [ OWNER ]: typeof geos;
+
+    /** @internal */
+    constructor(ptr: Ptr<PointGrid>, size: number) {
+        this[ OWNER ] = geos;
+        PointGridRef[ FINALIZATION ](this).register(this, ptr, this);
+        this[ POINTER ] = ptr;
+        this.size = size;
+    }
+
+    /**
+     * Finalization registry of the instance that owns `grid`
+     * @internal
+     */
+    static [ FINALIZATION ](grid: PointGridRef): FinalizationRegistry<Ptr<PointGrid>> {
+        const owner = grid[ OWNER ];
+        return owner.f_i ||= new FinalizationRegistry(ptr => PointGridRef[ CLEANUP ](ptr, owner));
+    }
+
+    /** @internal */
+    static [ CLEANUP ](ptr: Ptr<PointGrid>, owner: typeof geos): void {
+        owner.PointGrid_destroy(ptr);
+    }
+
+}
+
@@ -2,7 +2,7 @@ import type { GEOSGeometry, Ptr, u32 } from '../core/types/WasmGEOS.mjs';
 import type { STRtree } from '../core/types/WasmOther.mjs';
 import type { OutPtr } from '../core/reusable-memory.mjs';
 import type { Geometry } from '../geom/Geometry.mjs';
-import { CLEANUP, FINALIZATION, POINTER } from '../core/symbols.mjs';
+import { BUILD_TIME, CLEANUP, FINALIZATION, OWNER, POINTER } from '../core/symbols.mjs';
 import { GEOSError } from '../core/GEOSError.mjs';
 import { geos } from '../core/geos.mjs';
 
@@ -16,6 +16,59 @@ export interface STRTreeOptions {
      */
     nodeCapacity?: number;
 
+    /**
+     * Whether to collect query statistics, see {@link STRTreeRef#stats}.\
+     * Instrumented queries are slightly slower, so this is meant for tuning
+     * `nodeCapacity` and spotting regressions, not for production use.
+     * @default false
+     */
+    stats?: boolean;
+
+}
+
+/**
+ * Statistics collected by the tree created with `stats` option enabled.
+ * All counters are cumulative since the tree creation or the last
+ * {@link STRTreeRef#resetStats} call.
+ */
+export interface STRTreeStats {
+
+    /**
+     * Time in milliseconds it took to build the tree.
+     */
+    buildTime: number;
+
+    /**
+     * Number of queries made, including the nearest neighbor queries.
+     * Each box of {@link STRTreeRef#queryBBoxes} counts as one query.
+     */
+    queries: number;
+
+    /**
+     * Number of inner tree nodes whose children were tested against the
+     * query bbox. Not counted by the nearest neighbor queries.
+     */
+    nodesVisited: number;
+
+    /**
+     * Number of indexed geometries whose bbox was tested against the query
+     * bbox. Not counted by the nearest neighbor queries.
+     */
+    leafCandidates: number;
+
+    /**
+     * Number of returned matches.
+     * A `matches / leafCandidates` ratio far below 1 suggests that
+     * `nodeCapacity` is too large for the dataset.
+     */
+    matches: number;
+
+    /**
+     * Number of exact distance calculations made by the nearest neighbor
+     * queries.
+     */
+    distanceEvaluations: number;
+
 }
 
 /**
@@ -71,8 +124,14 @@ export function strTreeIndex<G extends Geometry>(geometries: G[], options?: STRT
         for (const geometry of geometries) {
             B[ b++ ] = geometry[ POINTER ];
         }
-        const treePtr = geos.STRtree_create(geoms, ngeoms, nodeCapacity);
-        return new STRTreeRef(treePtr, geometries);
+        const withStats = options?.stats;
+        const t0 = withStats ? performance.now() : 0;
+        const treePtr = geos.STRtree_create(geoms, ngeoms, nodeCapacity, +!!withStats);
+        const tree = new STRTreeRef(treePtr, geometries);
+        if (withStats) {
+            tree[ BUILD_TIME ] = performance.now() - t0;
+        }
+        return tree;
     } catch (e) {
         geos.free(geoms);
         throw e;
@@ -137,7 +196,150 @@ export class STRTreeRef<G extends Geometry = Geometry> {
     query(geometry: Geometry): G[] {
         const l = geos.u1 as OutPtr<u32>;
         const matchesPtr = geos.STRtree_query(this[ POINTER ], geometry[ POINTER ], l[ POINTER ]);
-        return selectMatches(this.geometries, matchesPtr, l);
+        return readMatches(this.geometries, matchesPtr >>> 2, l.get());
+    }
+
+    /**
+     * Returns all geometries whose [bounding box]{@link bounds} intersects
+     * with the given bounding box.
+     *
+     * Equivalent of `query(box([ xMin, yMin, xMax, yMax ]))` but without
+     * the need to create the query geometry.
+     *
+     * @param xMin - The minimum x-coordinate of the query box
+     * @param yMin - The minimum y-coordinate of the query box
+     * @param xMax - The maximum x-coordinate of the query box
+     * @param yMax - The maximum y-coordinate of the query box
+     * @returns An array of geometries whose bounding box intersects with the
+     * query box
+     *
+     * @see {@link STRTreeRef#queryBBoxes} to query multiple boxes at once
+     *
+     * @example #live
+     * const geometries = [
+     *     point([ 0, 2 ]), lineString([ [ 4, 2 ], [ 8, 2 ] ]),
+     *     point([ 0, 4 ]), point([ 4, 4 ]), point([ 8, 4 ]),
+     * ];
+     * const tree = strTreeIndex(geometries);
+     * const queryMatches = tree.queryBBox(2, 0, 6, 6);
+     * // [ <LINESTRING (4 2, 8 2)>, <POINT (4 4)> ]
+     */
+    queryBBox(xMin: number, yMin: number, xMax: number, yMax: number): G[] {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.STRtree_queryBBox(this[ POINTER ], xMin, yMin, xMax, yMax, l[ POINTER ]);
+        return readMatches(this.geometries, matchesPtr >>> 2, l.get());
+    }
+
+    /**
+     * Queries the tree with multiple bounding boxes at once.
+     *
+     * Each box is expected to be given as 4 consecutive numbers
+     * `[ xMin, yMin, xMax, yMax ]`, so the `bboxes.length` has to be a
+     * multiple of 4.
+     *
+     * @param bboxes - The flat array of query boxes
+     * @returns An array with matches for each query box, in the same order as
+     * the boxes
+     * @throws {GEOSError} when `bboxes.length` is not a multiple of 4
+     *
+     * @see {@link STRTreeRef#queryBBox} to query a single box
+     *
+     * @example #live
+     * const geometries = [
+     *     point([ 0, 2 ]), lineString([ [ 4, 2 ], [ 8, 2 ] ]),
+     *     point([ 0, 4 ]), point([ 4, 4 ]), point([ 8, 4 ]),
+     * ];
+     * const tree = strTreeIndex(geometries);
+     * const [ matches1, matches2 ] = tree.queryBBoxes(new Float64Array([
+     *     -1, 1, 1, 3,
+     *     7, 3, 9, 5,
+     * ]));
+     * // matches1 = [ <POINT (0 2)> ]
+     * // matches2 = [ <POINT (8 4)> ]
+     */
+    queryBBoxes(bboxes: Float64Array): G[][] {
+        const f64Length = bboxes.length;
+        if (f64Length % 4) {
+            throw new GEOSError('Bounding boxes array length must be a multiple of 4');
+        }
+        const n = f64Length / 4;
+        const buff = geos.buffByL(f64Length * 8);
+        try {
+            geos.F64.set(bboxes, buff[ POINTER ] / 8);
+            const l = geos.u1 as OutPtr<u32>;
+            const matchesPtr = geos.STRtree_queryBBoxes(this[ POINTER ], buff[ POINTER ], n, l[ POINTER ]);
+            // matches are read before anything else runs on the heap, see `readMatches`
+            const B = geos.U32, o = matchesPtr >>> 2, m = o + n + 1;
+            const results = Array<G[]>(n);
+            for (let i = 0; i < n; i++) {
+                const start = B[ o + i ];
+                results[ i ] = readMatches(this.geometries, m + start, B[ o + i + 1 ] - start);
+            }
+            return results;
+        } finally {
+            buff.freeIfTmp();
+        }
+    }
+
+    /**
+     * Same as {@link STRTreeRef#query} but returns indices of the matching
+     * geometries in the {@link STRTreeRef#geometries} array.
+     *
+     * When `out` array is provided, indices are written into it and the
+     * number of matches is returned instead, so that repeated queries do not
+     * allocate anything. When `out` is too short, only the first
+     * `out.length` indices are written; compare the returned count with
+     * `out.length` to detect that.
+     *
+     * @param geometry - The geometry whose bounding box will be used in the
+     * query
+     * @param out - Optional array to write the indices into
+     * @returns A new array of indices, or the number of matches when `out`
+     * is provided
+     *
+     * @example #live
+     * const geometries = [
+     *     point([ 0, 2 ]), lineString([ [ 4, 2 ], [ 8, 2 ] ]),
+     *     point([ 0, 4 ]), point([ 4, 4 ]), point([ 8, 4 ]),
+     * ];
+     * const tree = strTreeIndex(geometries);
+     * const selector = box([ 2, 0, 6, 6 ]);
+     *
+     * const indices = tree.queryIndices(selector);
+     * // Uint32Array [ 1, 3 ]
+     *
+     * const out = new Uint32Array(geometries.length); // allocated once
+     * const n = tree.queryIndices(selector, out);
+     * // n = 2, out = Uint32Array [ 1, 3, 0, 0, 0 ]
+     */
+    queryIndices(geometry: Geometry): Uint32Array;
+    queryIndices(geometry: Geometry, out: Uint32Array): number;
+    queryIndices(geometry: Geometry, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.STRtree_query(this[ POINTER ], geometry[ POINTER ], l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
+    }
+
+    /**
+     * Same as {@link STRTreeRef#queryBBox} but returns indices of the
+     * matching geometries in the {@link STRTreeRef#geometries} array.
+     *
+     * See {@link STRTreeRef#queryIndices} for the `out` array semantic.
+     *
+     * @param xMin - The minimum x-coordinate of the query box
+     * @param yMin - The minimum y-coordinate of the query box
+     * @param xMax - The maximum x-coordinate of the query box
+     * @param yMax - The maximum y-coordinate of the query box
+     * @param out - Optional array to write the indices into
+     * @returns A new array of indices, or the number of matches when `out`
+     * is provided
+     */
+    queryBBoxIndices(xMin: number, yMin: number, xMax: number, yMax: number): Uint32Array;
+    queryBBoxIndices(xMin: number, yMin: number, xMax: number, yMax: number, out: Uint32Array): number;
+    queryBBoxIndices(xMin: number, yMin: number, xMax: number, yMax: number, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.STRtree_queryBBox(this[ POINTER ], xMin, yMin, xMax, yMax, l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
     }
 
     /**
@@ -211,7 +413,68 @@ export class STRTreeRef<G extends Geometry = Geometry> {
     nearestAll(geometry: Geometry): G[] {
         const l = geos.u1 as OutPtr<u32>;
         const matchesPtr = geos.STRtree_nearestAll(this[ POINTER ], geometry[ POINTER ], l[ POINTER ]);
-        return selectMatches(this.geometries, matchesPtr, l);
+        return readMatches(this.geometries, matchesPtr >>> 2, l.get());
+    }
+
+    /**
+     * Same as {@link STRTreeRef#nearestAll} but returns indices of the
+     * nearest geometries in the {@link STRTreeRef#geometries} array.
+     *
+     * See {@link STRTreeRef#queryIndices} for the `out` array semantic.
+     *
+     * @param geometry - Geometry for which the nearest neighbors are queried
+     * @param out - Optional array to write the indices into
+     * @returns A new array of indices, or the number of matches when `out`
+     * is provided
+     * @throws {GEOSError} if any of the considered candidates for the nearest
+     * geometry is one of unsupported geometry types (curved)
+     */
+    nearestAllIndices(geometry: Geometry): Uint32Array;
+    nearestAllIndices(geometry: Geometry, out: Uint32Array): number;
+    nearestAllIndices(geometry: Geometry, out?: Uint32Array): Uint32Array | number {
+        const l = geos.u1 as OutPtr<u32>;
+        const matchesPtr = geos.STRtree_nearestAll(this[ POINTER ], geometry[ POINTER ], l[ POINTER ]);
+        return readIndices(matchesPtr, l.get(), out);
+    }
+
+    /**
+     * Returns statistics collected by the tree since its creation or the last
+     * {@link STRTreeRef#resetStats} call.
+     *
+     * @returns Statistics object, or `undefined` when the tree was created
+     * without `stats` option
+     *
+     * @example #live
+     * const geometries = Array.from({ length: 1000 }, (_, i) => point([ i % 40, Math.floor(i / 40) ]));
+     * const tree = strTreeIndex(geometries, { nodeCapacity: 4, stats: true });
+     * tree.queryBBox(10, 10, 12, 12);
+     * const stats = tree.stats();
+     * // { buildTime: ..., queries: 1, nodesVisited: ..., leafCandidates: ..., matches: 9, distanceEvaluations: 0 }
+     */
+    stats(): STRTreeStats | undefined {
+        const statsPtr = geos.STRtree_stats(this[ POINTER ]);
+        if (statsPtr) {
+            const F = geos.F64, f = statsPtr / 8;
+            return {
+                buildTime: this[ BUILD_TIME ],
+                queries: F[ f ],
+                nodesVisited: F[ f + 1 ],
+                leafCandidates: F[ f + 2 ],
+                matches: F[ f + 3 ],
+                distanceEvaluations: F[ f + 4 ],
+            };
+        }
+    }
+
+    /**
+     * Resets query counters returned by {@link STRTreeRef#stats}.
+     * Does nothing when the tree was created without `stats` option.
+     */
+    resetStats(): void {
+        const statsPtr = geos.STRtree_stats(this[ POINTER ]);
+        if (statsPtr) {
+            geos.F64.fill(0, statsPtr / 8, statsPtr / 8 + 5);
+        }
     }
 
     /**
@@ -223,44 +486,75 @@ export class STRTreeRef<G extends Geometry = Geometry> {
      * Manually freed object is marked as [detached]{@link STRTreeRef#detached}.
      */
     free(): void {
-        STRTreeRef[ FINALIZATION ].unregister(this);
-        STRTreeRef[ CLEANUP ](this[ POINTER ]);
+        STRTreeRef[ FINALIZATION ](this).unregister(this);
+        STRTreeRef[ CLEANUP ](this[ POINTER ], this[ OWNER ]);
         this.detached = true;
     }
 
     /** @internal */
     [ POINTER ]: Ptr<STRtree>;
 
+    /**
+     * The instance that owns the Wasm object, the active `geos` at the creation
+     * @internal
+     */
+    [ OWNER ]: typeof geos;
+
+    /** @internal */
+    [ BUILD_TIME ] = 0;
+
     /** @internal */
     constructor(ptr: Ptr<STRtree>, geometries: G[]) {
-        STRTreeRef[ FINALIZATION ].register(this, ptr, this);
+        this[ OWNER ] = geos;
+        STRTreeRef[ FINALIZATION ](this).register(this, ptr, this);
         this[ POINTER ] = ptr;
         this.geometries = geometries;
     }
 
-    /** @internal */
-    static readonly [ FINALIZATION ] = (
-        new FinalizationRegistry(STRTreeRef[ CLEANUP ])
-    );
+    /**
+     * Finalization registry of the instance that owns `tree`
+     * @internal
+     */
+    static [ FINALIZATION ](tree: STRTreeRef<any>): FinalizationRegistry<Ptr<STRtree>> {
+        const owner = tree[ OWNER ];
+        return owner.f_t ||= new FinalizationRegistry(ptr => STRTreeRef[ CLEANUP ](ptr, owner));
+    }
 
     /** @internal */
-    static [ CLEANUP ](ptr: Ptr<STRtree>): void {
-        geos.STRtree_destroy(ptr);
+    static [ CLEANUP ](ptr: Ptr<STRtree>, owner: typeof geos): void {
+        owner.STRtree_destroy(ptr);
     }
 
 }
 
 
-function selectMatches<G extends Geometry>(geometries: G[], matchesPtr: Ptr<u32> | 0, l: OutPtr<u32>): G[] {
-    if (matchesPtr) {
-        const matchesLength = l.get();
-        const matches = Array<G>(matchesLength);
-        let B = geos.U32, b = matchesPtr >>> 2;
-        for (let i = 0; i < matchesLength; i++) {
-            matches[ i ] = geometries[ B[ b++ ] ];
-        }
-        geos.free(matchesPtr);
-        return matches;
+/**
+ * Query results are views into the reusable output buffer of the index
+ * (`tree->matches`, `g->matches` in C), which is valid only until the next
+ * query on the same index or until the index is destroyed. They must be
+ * copied out right after the query call, before anything else can run on
+ * the heap; `readMatches` and `readIndices` are the only places that read
+ * them.
+ */
+function readMatches<G extends Geometry>(geometries: G[], b: number, matchesLength: number): G[] {
+    const matches = Array<G>(matchesLength);
+    const B = geos.U32;
+    for (let i = 0; i < matchesLength; i++) {
+        matches[ i ] = geometries[ B[ b++ ] ];
+    }
+    return matches;
+}
+
+/**
+ * Copies indices of a query result out of the wasm memory, see `readMatches`
+ * for the lifetime of `matchesPtr`
+ * @internal
+ */
+export function readIndices(matchesPtr: Ptr<u32>, matchesLength: number, out: Uint32Array | undefined): Uint32Array | number {
+    const b = matchesPtr >>> 2;
+    if (out) {
+        out.set(geos.U32.subarray(b, b + Math.min(matchesLength, out.length)));
+        return matchesLength;
     }
-    return [];
+    return geos.U32.slice(b, b + matchesLength);
 }
@@ -0,0 +1,114 @@
+import type { Ptr, u32 } from '../core/types/WasmGEOS.mjs';
+import type { Geometry } from '../geom/Geometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+/**
+ * Calculates [Hilbert curve]{@link https://en.wikipedia.org/wiki/Hilbert_curve}
+ * codes of the geometries.
+ *
+ * The code is calculated for the center of the geometry bounding box, on
+ * a 65536 x 65536 grid (level 16) that spans the `extent`.
+ * Geometries that are close to each other tend to have similar codes.
+ *
+ * Empty geometries get code `0`.
+ *
+ * @param geometries - The array of geometries
+ * @param extent - The extent `[ xMin, yMin, xMax, yMax ]` of the Hilbert
+ * curve grid; by default, the extent of all the geometries. Centers outside
+ * the extent are clamped to the extent.
+ * @returns An array of codes, one per geometry
+ * @throws {GEOSError} when `extent` is not valid
+ *
+ * @see {@link hilbertSort} to sort geometries by their Hilbert code
+ *
+ * @example #live
+ * const codes = hilbertCodes([
+ *     point([ 0, 0 ]),
+ *     point([ 0, 10 ]),
+ *     point([ 10, 10 ]),
+ *     point([ 10, 0 ]),
+ *     point([]),
+ * ]);
+ * // Uint32Array [ 0, 1431655765, 2863311530, 4294967295, 0 ]
+ */
+export function hilbertCodes(geometries: Geometry[], extent?: number[]): Uint32Array {
+    return computeCodes(geometries, extent, false);
+}
+
+/**
+ * Sorts geometries by the [Hilbert curve]{@link https://en.wikipedia.org/wiki/Hilbert_curve}
+ * code of their bounding box center, see {@link hilbertCodes}.
+ *
+ * Geometries that are close to each other end up close to each other in the
+ * sorted array. Sorting the input this way before [indexing]{@link strTreeIndex},
+ * [union]{@link unaryUnion} or serialization usually improves the memory
+ * locality of the operation and the compression ratio of the output.
+ *
+ * The sort is stable. Empty geometries are placed at the end of the array.
+ * The input array is not modified.
+ *
+ * @template G - The type of geometry
+ * @param geometries - The array of geometries to sort
+ * @param extent - The extent `[ xMin, yMin, xMax, yMax ]` of the Hilbert
+ * curve grid; by default, the extent of all the geometries
+ * @returns A new array with geometries sorted by their Hilbert code
+ * @throws {GEOSError} when `extent` is not valid
+ *
+ * @example #live
+ * const sorted = hilbertSort([
+ *     point([ 10, 0 ]),
+ *     point([]),
+ *     point([ 10, 10 ]),
+ *     point([ 0, 0 ]),
+ *     point([ 0, 10 ]),
+ * ]);
+ * // [ <POINT (0 0)>, <POINT (0 10)>, <POINT (10 10)>, <POINT (10 0)>, <POINT EMPTY> ]
+ */
+export function hilbertSort<G extends Geometry>(geometries: G[], extent?: number[]): G[] {
+    const order = computeCodes(geometries, extent, true);
+    const sorted = Array<G>(geometries.length);
+    for (let i = 0; i < sorted.length; i++) {
+        sorted[ i ] = geometries[ order[ i ] ];
+    }
+    return sorted;
+}
+
+
+const computeCodes = (geometries: Geometry[], extent: number[] | undefined, sort: boolean): Uint32Array => {
+    if (extent) {
+        const [ xMin, yMin, xMax, yMax ] = extent;
+        if (!(xMin <= xMax && yMin <= yMax)) {
+            throw new GEOSError('Invalid extent');
+        }
+    }
+
+    const n = geometries.length;
+    // [extent: f64 x4][geometries/codes: u32 x n][order: u32 x n]
+    const buff = geos.buffByL4(8 + n * 2);
+    try {
+        const extentPtr = buff[ POINTER ];
+        const geomsPtr = extentPtr + 32 as Ptr<any>, orderPtr = geomsPtr + n * 4 as Ptr<u32[]>;
+        const F = geos.F64, f = extentPtr / 8;
+        if (extent) {
+            F[ f ] = extent[ 0 ];
+            F[ f + 1 ] = extent[ 1 ];
+            F[ f + 2 ] = extent[ 2 ];
+            F[ f + 3 ] = extent[ 3 ];
+        } else {
+            F[ f ] = 1; // xMin > xMax - compute extent from geometries
+            F[ f + 2 ] = 0;
+        }
+        let B = geos.U32, b = geomsPtr / 4;
+        for (const geometry of geometries) {
+            B[ b++ ] = geometry[ POINTER ];
+        }
+        geos.hilbert_codes(geomsPtr, n, extentPtr, geomsPtr, sort ? orderPtr : 0);
+        const r = (sort ? orderPtr : geomsPtr) / 4;
+        return geos.U32.slice(r, r + n);
+    } finally {
+        buff.freeIfTmp();
+    }
+};
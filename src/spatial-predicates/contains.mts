@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
 import { P_POINTER, POINTER } from '../core/symbols.mjs';
-import { prepare, type Prepared } from '../geom/PreparedGeometry.mjs';
+import { prepare, type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany, predicateXYMany } from './many.mjs';
+import { envelopeNotCovers } from '../geom/envelope.mjs';
 
 
 /**
@@ -73,14 +75,79 @@ import { geos } from '../core/geos.mjs';
  * const gh_contain = contains(g, h); // false
  */
 export function contains(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopeNotCovers(a, b)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedContains(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedContains(pPtr, b[ POINTER ])
             : geos.GEOSContains(a[ POINTER ], b[ POINTER ]),
     );
 }
 
 
+/**
+ * Same as {@link contains}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `contains(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = containsMany(a, bs); // Uint8Array [ 1, 0, 0 ]
+ */
+export function containsMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('contains', a, bs);
+}
+
+
+/**
+ * Returns for each point whether it lies in the interior of geometry `a`,
+ * see {@link contains}.
+ *
+ * Points are given as a flat array of coordinates and tested without
+ * creating any Point geometry.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns. Prepare
+ * `a` to reuse it across calls. With {@link autoPrepare} enabled, the call
+ * also counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - Geometry to test the points against
+ * @param coords - The flat array of point coordinates `[ x1, y1, x2, y2, ... ]`
+ * @returns An array where `i`-th element is `1` when `a` contains `i`-th
+ * point, and `0` otherwise
+ * @throws {GEOSError} when `coords.length` is odd
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @see {@link intersectsXY} also matches points on the boundary of `a`
+ *
+ * @example #live
+ * const zone = polygon([ [ [ 0, 0 ], [ 0, 4 ], [ 4, 4 ], [ 4, 0 ], [ 0, 0 ] ] ]);
+ * const result = containsXY(zone, new Float64Array([
+ *     2, 2, // inside
+ *     4, 2, // on the boundary
+ *     6, 6, // outside
+ * ]));
+ * // Uint8Array [ 1, 0, 0 ]
+ */
+export function containsXY(a: Geometry | Prepared<Geometry>, coords: Float64Array): Uint8Array {
+    return predicateXYMany('contains', a, coords);
+}
+
+
 /**
  * Returns `true` if geometry `b` lies in the interior of geometry `a`.
  *
@@ -143,6 +210,9 @@ export function contains(a: Geometry | Prepared<Geometry>, b: Geometry): boolean
  * const gh_containsProperly = containsProperly(g, h); // true
  */
 export function containsProperly(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopeNotCovers(a, b)) {
+        return false;
+    }
     if (!a[ P_POINTER ]) {
         prepare(a);
     }
@@ -150,6 +220,32 @@ export function containsProperly(a: Geometry | Prepared<Geometry>, b: Geometry):
 }
 
 
+/**
+ * Same as {@link containsProperly}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `containsProperly(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = containsProperlyMany(a, bs); // Uint8Array [ 1, 0, 0 ]
+ */
+export function containsProperlyMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('containsProperly', a, bs);
+}
+
+
 /**
  * Returns `true` if geometry `a` lies in geometry `b` and their interiors intersect.
  *
@@ -204,9 +300,39 @@ export function containsProperly(a: Geometry | Prepared<Geometry>, b: Geometry):
  * const gh_within = within(g, h); // true
  */
 export function within(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopeNotCovers(b, a)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedWithin(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedWithin(pPtr, b[ POINTER ])
             : geos.GEOSWithin(a[ POINTER ], b[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link within}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `within(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = point([ 2, 2 ]);
+ * const bs = [ box([ 0, 0, 4, 4 ]), box([ 2, 0, 4, 4 ]), box([ 5, 5, 6, 6 ]) ];
+ * const result = withinMany(a, bs); // Uint8Array [ 1, 0, 0 ]
+ */
+export function withinMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('within', a, bs);
+}
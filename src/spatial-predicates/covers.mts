@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany } from './many.mjs';
+import { envelopeNotCovers } from '../geom/envelope.mjs';
 
 
 /**
@@ -40,14 +42,44 @@ import { geos } from '../core/geos.mjs';
  * const cd_cover = covers(c, d); // true
  */
 export function covers(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopeNotCovers(a, b)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedCovers(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedCovers(pPtr, b[ POINTER ])
             : geos.GEOSCovers(a[ POINTER ], b[ POINTER ]),
     );
 }
 
 
+/**
+ * Same as {@link covers}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `covers(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = coversMany(a, bs); // Uint8Array [ 1, 1, 0 ]
+ */
+export function coversMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('covers', a, bs);
+}
+
+
 /**
  * Returns `true` if geometry `a` lies in geometry `b`.
  *
@@ -86,9 +118,39 @@ export function covers(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
  * const gh_coveredBy = coveredBy(g, h); // true
  */
 export function coveredBy(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopeNotCovers(b, a)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedCoveredBy(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedCoveredBy(pPtr, b[ POINTER ])
             : geos.GEOSCoveredBy(a[ POINTER ], b[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link coveredBy}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `coveredBy(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = point([ 2, 2 ]);
+ * const bs = [ box([ 0, 0, 4, 4 ]), box([ 2, 0, 4, 4 ]), box([ 5, 5, 6, 6 ]) ];
+ * const result = coveredByMany(a, bs); // Uint8Array [ 1, 1, 0 ]
+ */
+export function coveredByMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('coveredBy', a, bs);
+}
@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany } from './many.mjs';
+import { envelopesDisjoint } from '../geom/envelope.mjs';
 
 
 /**
@@ -65,9 +67,43 @@ import { geos } from '../core/geos.mjs';
  * const gh_cross = crosses(g, h); // false - intersection is line not a point
  */
 export function crosses(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopesDisjoint(a, b)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedCrosses(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedCrosses(pPtr, b[ POINTER ])
             : geos.GEOSCrosses(a[ POINTER ], b[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link crosses}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `crosses(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = lineString([ [ 0, 0 ], [ 4, 4 ] ]);
+ * const bs = [
+ *     lineString([ [ 0, 4 ], [ 4, 0 ] ]),
+ *     lineString([ [ 4, 4 ], [ 6, 6 ] ]),
+ *     box([ 1, 0, 3, 2 ]),
+ * ];
+ * const result = crossesMany(a, bs); // Uint8Array [ 1, 0, 1 ]
+ */
+export function crossesMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('crosses', a, bs);
+}
@@ -1,6 +1,8 @@
 import type { Geometry } from '../geom/Geometry.mjs';
 import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany } from './many.mjs';
+import { envelopesDisjoint } from '../geom/envelope.mjs';
 
 
 /**
@@ -51,5 +53,32 @@ import { geos } from '../core/geos.mjs';
  * const emptyEmpty = equals(point([]), polygon([])); // true
  */
 export function equals(a: Geometry, b: Geometry): boolean {
+    if (envelopesDisjoint(a, b)) {
+        return false;
+    }
     return Boolean(geos.GEOSEquals(a[ POINTER ], b[ POINTER ]));
 }
+
+
+/**
+ * Same as {@link equals}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `equals(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = lineString([ [ 0, 0 ], [ 2, 2 ] ]);
+ * const bs = [
+ *     lineString([ [ 2, 2 ], [ 0, 0 ] ]),
+ *     lineString([ [ 0, 0 ], [ 1, 1 ], [ 2, 2 ] ]),
+ *     lineString([ [ 0, 0 ], [ 2, 0 ] ]),
+ * ];
+ * const result = equalsMany(a, bs); // Uint8Array [ 1, 1, 0 ]
+ */
+export function equalsMany(a: Geometry, bs: Geometry[]): Uint8Array {
+    return predicateMany('equals', a, bs);
+}
@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany, predicateXYMany } from './many.mjs';
+import { envelopesDisjoint } from '../geom/envelope.mjs';
 
 
 /**
@@ -35,14 +37,79 @@ import { geos } from '../core/geos.mjs';
  * const cd_intersect = intersects(c, d); // true
  */
 export function intersects(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopesDisjoint(a, b)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedIntersects(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedIntersects(pPtr, b[ POINTER ])
             : geos.GEOSIntersects(a[ POINTER ], b[ POINTER ]),
     );
 }
 
 
+/**
+ * Same as {@link intersects}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `intersects(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = intersectsMany(a, bs); // Uint8Array [ 1, 1, 0 ]
+ */
+export function intersectsMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('intersects', a, bs);
+}
+
+
+/**
+ * Returns for each point whether it intersects geometry `a`, see
+ * {@link intersects}.
+ *
+ * Points are given as a flat array of coordinates and tested without
+ * creating any Point geometry.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns. Prepare
+ * `a` to reuse it across calls. With {@link autoPrepare} enabled, the call
+ * also counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - Geometry to test the points against
+ * @param coords - The flat array of point coordinates `[ x1, y1, x2, y2, ... ]`
+ * @returns An array where `i`-th element is `1` when `a` intersects `i`-th
+ * point, and `0` otherwise
+ * @throws {GEOSError} when `coords.length` is odd
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @see {@link containsXY} does not match points on the boundary of `a`
+ *
+ * @example #live
+ * const zone = polygon([ [ [ 0, 0 ], [ 0, 4 ], [ 4, 4 ], [ 4, 0 ], [ 0, 0 ] ] ]);
+ * const result = intersectsXY(zone, new Float64Array([
+ *     2, 2, // inside
+ *     4, 2, // on the boundary
+ *     6, 6, // outside
+ * ]));
+ * // Uint8Array [ 1, 1, 0 ]
+ */
+export function intersectsXY(a: Geometry | Prepared<Geometry>, coords: Float64Array): Uint8Array {
+    return predicateXYMany('intersects', a, coords);
+}
+
+
 /**
  * Returns `true` if geometries `a` and `b` have no points in common.
  *
@@ -72,9 +139,39 @@ export function intersects(a: Geometry | Prepared<Geometry>, b: Geometry): boole
  * const cd_disjoint = disjoint(c, d); // false
  */
 export function disjoint(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopesDisjoint(a, b)) {
+        return true;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedDisjoint(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedDisjoint(pPtr, b[ POINTER ])
             : geos.GEOSDisjoint(a[ POINTER ], b[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link disjoint}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `disjoint(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = disjointMany(a, bs); // Uint8Array [ 0, 0, 1 ]
+ */
+export function disjointMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('disjoint', a, bs);
+}
@@ -0,0 +1,97 @@
+import type { GEOSPreparedGeometry, Ptr } from '../core/types/WasmGEOS.mjs';
+import type { Geometry } from '../geom/Geometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
+import { batchPreparedPtr } from '../geom/PreparedGeometry.mjs';
+import { GEOSError } from '../core/GEOSError.mjs';
+import { geos } from '../core/geos.mjs';
+
+
+/** Predicate op codes, must match `PredicateOp` enum in `geos_js.cpp` */
+const PredicateOpIdMap = {
+    intersects: 0,
+    disjoint: 1,
+    contains: 2,
+    containsProperly: 3,
+    within: 4,
+    covers: 5,
+    coveredBy: 6,
+    crosses: 7,
+    overlaps: 8,
+    touches: 9,
+    equals: 10,
+    relatePattern: 11,
+} as const;
+
+/** @internal */
+export type PredicateOp = keyof typeof PredicateOpIdMap;
+
+/**
+ * Evaluates predicate `op` between `a` and each of `bs` in a single Wasm call.
+ *
+ * `a` is prepared for the call, unless `op` has no prepared version, see
+ * `batchPreparedPtr`.
+ *
+ * @internal
+ */
+export function predicateMany(op: PredicateOp, a: Geometry, bs: Geometry[], pattern?: string): Uint8Array {
+    let pa: Ptr<GEOSPreparedGeometry> | 0 = 0, temporary = false;
+    if (op !== 'equals') {
+        [ pa, temporary ] = batchPreparedPtr(a);
+    }
+
+    const n = bs.length;
+    const patternLength = pattern?.length ?? 0;
+    // [bs: u32 x n][pattern: u8 x (patternLength + 1)]
+    const buff = geos.buffByL(n * 4 + patternLength + 1);
+    try {
+        const bsPtr = buff[ POINTER ];
+        let B = geos.U32, b = buff.i4;
+        for (const geometry of bs) {
+            B[ b++ ] = geometry[ POINTER ];
+        }
+
+        let patternPtr: Ptr<string> | 0 = 0;
+        if (pattern !== undefined) {
+            patternPtr = bsPtr + n * 4 as Ptr<string>;
+            geos.encodeStringAt(pattern, patternPtr);
+        }
+
+        geos.predicates_many(PredicateOpIdMap[ op ], a[ POINTER ], pa, bsPtr, n, patternPtr, bsPtr);
+        return geos.U8.slice(bsPtr, bsPtr + n);
+    } finally {
+        buff.freeIfTmp();
+        if (pa && temporary) {
+            geos.GEOSPreparedGeom_destroy(pa);
+        }
+    }
+}
+
+
+/**
+ * Evaluates prepared `contains` or `intersects` between `a` and each of the
+ * points in a single Wasm call, `a` is prepared for the call, see
+ * `batchPreparedPtr`.
+ *
+ * @internal
+ */
+export function predicateXYMany(op: 'contains' | 'intersects', a: Geometry, coords: Float64Array): Uint8Array {
+    const f64Length = coords.length;
+    if (f64Length % 2) {
+        throw new GEOSError('Coordinates array length must be a multiple of 2');
+    }
+    const [ pa, temporary ] = batchPreparedPtr(a);
+
+    const n = f64Length / 2;
+    const buff = geos.buffByL(f64Length * 8);
+    try {
+        const xyPtr = buff[ POINTER ];
+        geos.F64.set(coords, xyPtr / 8);
+        geos.predicates_xy_many(+(op === 'intersects'), pa, xyPtr, n, xyPtr);
+        return geos.U8.slice(xyPtr, xyPtr + n);
+    } finally {
+        buff.freeIfTmp();
+        if (temporary) {
+            geos.GEOSPreparedGeom_destroy(pa);
+        }
+    }
+}
@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { batchPreparedPtr, type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany } from './many.mjs';
+import { type BatchOptions, pairwiseU8 } from '../core/pairwise.mjs';
 
 
 /**
@@ -37,8 +39,9 @@ import { geos } from '../core/geos.mjs';
  * const ba_relate = relate(b, a); // 'FF10F0FF2'
  */
 export function relate(a: Geometry | Prepared<Geometry>, b: Geometry): string {
-    const strPtr = a[ P_POINTER ]
-        ? geos.GEOSPreparedRelate(a[ P_POINTER ], b[ POINTER ])
+    const pPtr = preparedPtr(a);
+    const strPtr = pPtr
+        ? geos.GEOSPreparedRelate(pPtr, b[ POINTER ])
         : geos.GEOSRelate(a[ POINTER ], b[ POINTER ]);
     const str = geos.decodeString(strPtr);
     geos.free(strPtr);
@@ -46,6 +49,49 @@ export function relate(a: Geometry | Prepared<Geometry>, b: Geometry): string {
 }
 
 
+/**
+ * Same as {@link relate}, but computes DE-9IM matrices of many pairs of
+ * geometries in a single Wasm call, without creating a string per pair.
+ *
+ * Matrices are packed into fixed 9-byte records, each byte is a char code
+ * of the matrix string, one of `F`,`0`,`1`,`2` (70, 48, 49, 50).
+ *
+ * When `a` is a single geometry, it is tested against each of the
+ * geometries `bs`, and is [prepared]{@link prepare} for the call, unless it
+ * already is; the temporary preparation is freed when the call returns.
+ * When `a` is an array, arrays `a` and `bs` are processed element-wise.
+ *
+ * @param a - First geometry or array of first geometries
+ * @param bs - Array of second geometries
+ * @param options - Optional batch options, see {@link BatchOptions}
+ * @returns A flat array of `9 * bs.length` bytes, where the matrix of
+ * `i`-th pair starts at index `9 * i`; all zeros for failed pairs
+ * @throws {GEOSError} when `a` and `bs` are arrays of different lengths
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = lineString([ [ 0, 0 ], [ 1, 0 ] ]);
+ * const bs = [ point([ 0, 0 ]), point([ 0.5, 0 ]) ];
+ * const matrices = relateMany(a, bs);
+ * const first = String.fromCharCode(...matrices.subarray(0, 9)); // 'FF10F0FF2'
+ * const second = String.fromCharCode(...matrices.subarray(9, 18)); // '0F1FF0FF2'
+ * const isInterior = matrices[ 9 ] !== 70; // true - interior of `a` intersects `bs[ 1 ]`
+ */
+export function relateMany(a: Geometry | Prepared<Geometry> | Geometry[], bs: Geometry[], options?: BatchOptions): Uint8Array {
+    if (Array.isArray(a)) {
+        return pairwiseU8('relate', a, bs, { ...options, record: 9 });
+    }
+    const [ prepared, temporary ] = batchPreparedPtr(a);
+    try {
+        return pairwiseU8('relate', a, bs, { ...options, record: 9, prepared });
+    } finally {
+        if (temporary) {
+            geos.GEOSPreparedGeom_destroy(prepared);
+        }
+    }
+}
+
+
 /**
  * Returns `true` if the spatial relationship between geometries `a` and `b`
  * matches the specified [DE-9IM]{@link https://en.wikipedia.org/wiki/DE-9IM}
@@ -87,10 +133,49 @@ export function relate(a: Geometry | Prepared<Geometry>, b: Geometry): string {
  * const ab_contains = relatePattern(a, b, 'T*****FF*'); // false - `a` do not contain `b`
  */
 export function relatePattern(a: Geometry | Prepared<Geometry>, b: Geometry, pattern: string): boolean {
+    const pPtr = preparedPtr(a);
     const buff = geos.encodeString(pattern);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedRelatePattern(a[ P_POINTER ], b[ POINTER ], buff[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedRelatePattern(pPtr, b[ POINTER ], buff[ POINTER ])
             : geos.GEOSRelatePattern(a[ POINTER ], b[ POINTER ], buff[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link relatePattern}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * When `a` is an array, arrays `a` and `bs` are processed element-wise
+ * instead, `i`-th result tells whether `a[ i ]` and `bs[ i ]` match the pattern.
+ *
+ * @param a - First geometry or array of first geometries
+ * @param bs - Array of second geometries
+ * @param pattern - DE-9IM pattern, 9-character string where each character is
+ * one of `F`,`0`,`1`,`2`,`T`,`*`
+ * @returns An array where `i`-th element is `1` when
+ * `relatePattern(a, bs[ i ], pattern)` is `true`, and `0` otherwise
+ * @throws {GEOSError} when `a` and `bs` are arrays of different lengths
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]) ];
+ * const result = relatePatternMany(a, bs, 'T*****FF*'); // Uint8Array [ 1, 0, 0 ]
+ *
+ * const as = [ box([ 0, 0, 4, 4 ]), point([ 0, 0 ]), point([ 6, 6 ]) ];
+ * const pairs = relatePatternMany(as, bs, 'T********'); // Uint8Array [ 1, 0, 1 ]
+ */
+export function relatePatternMany(a: Geometry | Prepared<Geometry> | Geometry[], bs: Geometry[], pattern: string): Uint8Array {
+    if (Array.isArray(a)) {
+        return pairwiseU8('relatePattern', a, bs, { pattern });
+    }
+    return predicateMany('relatePattern', a, bs, pattern);
+}
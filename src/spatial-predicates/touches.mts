@@ -1,7 +1,9 @@
 import type { Geometry } from '../geom/Geometry.mjs';
-import type { Prepared } from '../geom/PreparedGeometry.mjs';
-import { P_POINTER, POINTER } from '../core/symbols.mjs';
+import { type Prepared, preparedPtr } from '../geom/PreparedGeometry.mjs';
+import { POINTER } from '../core/symbols.mjs';
 import { geos } from '../core/geos.mjs';
+import { predicateMany } from './many.mjs';
+import { envelopesDisjoint } from '../geom/envelope.mjs';
 
 
 /**
@@ -70,9 +72,39 @@ import { geos } from '../core/geos.mjs';
  * const kl_touch = touches(k, l); // false
  */
 export function touches(a: Geometry | Prepared<Geometry>, b: Geometry): boolean {
+    if (envelopesDisjoint(a, b)) {
+        return false;
+    }
+    const pPtr = preparedPtr(a);
     return Boolean(
-        a[ P_POINTER ]
-            ? geos.GEOSPreparedTouches(a[ P_POINTER ], b[ POINTER ])
+        pPtr
+            ? geos.GEOSPreparedTouches(pPtr, b[ POINTER ])
             : geos.GEOSTouches(a[ POINTER ], b[ POINTER ]),
     );
 }
+
+
+/**
+ * Same as {@link touches}, but tests geometry `a` against each of the
+ * geometries `bs` in a single Wasm call.
+ *
+ * Geometry `a` is [prepared]{@link prepare} for the call, unless it already
+ * is, and the temporary preparation is freed when the call returns; for
+ * one-vs-many comparisons preparing pays off almost immediately. Prepare `a`
+ * to reuse it across calls. With {@link autoPrepare} enabled, the call also
+ * counts as a use of `a`, which may prepare it for good.
+ *
+ * @param a - First geometry
+ * @param bs - Array of second geometries
+ * @returns An array where `i`-th element is `1` when
+ * `touches(a, bs[ i ])` is `true`, and `0` otherwise
+ * @throws {GEOSError} on unsupported geometry types (curved)
+ *
+ * @example #live
+ * const a = box([ 0, 0, 4, 4 ]);
+ * const bs = [ box([ 2, 2, 6, 6 ]), box([ 1, 1, 3, 3 ]), box([ 4, 0, 6, 4 ]) ];
+ * const result = touchesMany(a, bs); // Uint8Array [ 0, 0, 1 ]
+ */
+export function touchesMany(a: Geometry | Prepared<Geometry>, bs: Geometry[]): Uint8Array {
+    return predicateMany('touches', a, bs);
+}
@@ -3,7 +3,7 @@ import { before, describe, it, mock } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
 import { POINTER } from '../../src/core/symbols.mjs';
 import { lineString } from '../../src/helpers/helpers.mjs';
-import { geos } from '../../src/core/geos.mjs';
+import { geos, instantiateDetached } from '../../src/core/geos.mjs';
 
 
 describe('geos', () => {
@@ -164,4 +164,23 @@ describe('geos', () => {
 
     });
 
+    describe('module version', () => {
+
+        it('should reject a module built from other sources', async () => {
+            // module with a memory export only, like the ones built before `abi_version`
+            const module = await WebAssembly.compile(new Uint8Array([
+                0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, // header
+                0x05, 0x03, 0x01, 0x00, 0x01, // memory section: 1 memory, min 1 page
+                0x07, 0x0a, 0x01, 0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00, // export section: "memory"
+            ]));
+            const active = geos;
+            await assert.rejects(instantiateDetached(module), {
+                name: 'GEOSError',
+                message: 'Wasm module is out of date with the JS sources (interface version unknown, expected 1), rebuild it with `make geos-js-build`',
+            });
+            assert.equal(geos, active);
+        });
+
+    });
+
 });
@@ -0,0 +1,189 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import type { Geometry } from '../../src/geom/Geometry.mjs';
+import { box, lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { intersection, intersectionMany } from '../../src/operations/intersection.mjs';
+import { difference, differenceMany } from '../../src/operations/difference.mjs';
+import { symmetricDifference, symmetricDifferenceMany } from '../../src/operations/symmetricDifference.mjs';
+import { union, unionMany } from '../../src/operations/union.mjs';
+import { buffer, bufferMany } from '../../src/operations/buffer.mjs';
+import { distance, distanceMany } from '../../src/measurement/distance.mjs';
+import { distanceWithin, distanceWithinMany } from '../../src/predicates/distanceWithin.mjs';
+import { relate, relateMany, relatePattern, relatePatternMany } from '../../src/spatial-predicates/relate.mjs';
+import { isEmpty } from '../../src/predicates/isEmpty.mjs';
+import { isPrepared } from '../../src/predicates/isPrepared.mjs';
+import { prepare } from '../../src/geom/PreparedGeometry.mjs';
+import { fromWKT, toWKT } from '../../src/io/WKT.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('pairwise operations', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    const makeAs = (): Geometry[] => [
+        box([ 0, 0, 4, 4 ]), box([ 2, 2, 6, 6 ]), point([ 1, 1 ]), lineString([ [ 0, 0 ], [ 4, 4 ] ]),
+        polygon([]), box([ 10, 10, 11, 11 ]),
+    ];
+    const makeBs = (): Geometry[] => [
+        box([ 1, 1, 3, 3 ]), point([ 3, 3 ]), box([ 0, 0, 2, 2 ]), box([ 2, 0, 3, 8 ]),
+        box([ 0, 0, 1, 1 ]), point([ 20, 20 ]),
+    ];
+
+    it('should return the same geometries as single operations', () => {
+        const as = makeAs(), bs = makeBs();
+        const pairs: [ (a: Geometry, b: Geometry, o?: { gridSize?: number }) => Geometry, (a: Geometry | Geometry[], b: Geometry | Geometry[], o?: { gridSize?: number }) => Geometry[] ][] = [
+            [ intersection, intersectionMany ],
+            [ difference, differenceMany ],
+            [ symmetricDifference, symmetricDifferenceMany ],
+            [ union, unionMany ],
+        ];
+        for (const [ single, many ] of pairs) {
+            for (const options of [ undefined, { gridSize: 0.5 } ]) {
+                const expected = as.map((a, i) => toWKT(single(a, bs[ i ], options)));
+                assert.deepEqual(many(as, bs, options).map(g => toWKT(g)), expected, many.name);
+                // broadcast of a single geometry
+                assert.deepEqual(
+                    many(as[ 0 ], bs, options).map(g => toWKT(g)),
+                    bs.map(b => toWKT(single(as[ 0 ], b, options))),
+                );
+                assert.deepEqual(
+                    many(as, bs[ 0 ], options).map(g => toWKT(g)),
+                    as.map(a => toWKT(single(a, bs[ 0 ], options))),
+                );
+            }
+        }
+    });
+
+    it('should create result geometries with types written by Wasm', () => {
+        const as = makeAs(), bs = makeBs();
+        // types as reported by GEOS for single operations
+        const expected = [ ...as.map((a, i) => union(a, bs[ i ]).type), ...as.map(a => buffer(a, 1).type) ];
+        const GEOSGeomTypeId = mock.method(geos, 'GEOSGeomTypeId');
+        try {
+            const results = [ ...unionMany(as, bs), ...bufferMany(as, 1) ];
+            assert.deepEqual(results.map(g => g.type), expected);
+            assert.equal(GEOSGeomTypeId.mock.callCount(), 0);
+        } finally {
+            GEOSGeomTypeId.mock.restore();
+        }
+    });
+
+    it('should return the same buffers as single buffer', () => {
+        const as = makeAs();
+        const options = { quadrantSegments: 2, endCapStyle: 'flat' } as const;
+        assert.deepEqual(
+            bufferMany(as, 1.5, options).map(g => toWKT(g)),
+            as.map(a => toWKT(buffer(a, 1.5, options))),
+        );
+    });
+
+    it('should return the same distances as single distance', () => {
+        const as = makeAs(), bs = makeBs();
+        const expected = Float64Array.from(as, (a, i) => (
+            isEmpty(a) || isEmpty(bs[ i ]) ? NaN : distance(a, bs[ i ])
+        ));
+        assert.deepEqual(distanceMany(as, bs), expected);
+        assert.deepEqual(distanceMany(prepare(as[ 1 ]), bs), Float64Array.from(bs, b => distance(as[ 1 ], b)));
+
+        assert.deepEqual(distanceWithinMany(as, bs, 2), Uint8Array.from(as, (a, i) => +distanceWithin(a, bs[ i ], 2)));
+        assert.deepEqual(distanceWithinMany(prepare(as[ 0 ]), bs, 2), Uint8Array.from(bs, b => +distanceWithin(as[ 0 ], b, 2)));
+    });
+
+    it('should return the same results as single relatePattern', () => {
+        const as = makeAs(), bs = makeBs();
+        for (const pattern of [ 'T*****FF*', 'T********', 'FF*FF****' ]) {
+            assert.deepEqual(relatePatternMany(as, bs, pattern), Uint8Array.from(as, (a, i) => +relatePattern(a, bs[ i ], pattern)));
+        }
+    });
+
+    it('should return the same matrices as single relate', () => {
+        const as = makeAs(), bs = makeBs();
+        const decode = (matrices: Uint8Array) => (
+            Array.from({ length: matrices.length / 9 }, (_, i) => String.fromCharCode(...matrices.subarray(i * 9, i * 9 + 9)))
+        );
+        assert.deepEqual(decode(relateMany(as, bs)), as.map((a, i) => relate(a, bs[ i ])));
+        assert.deepEqual(decode(relateMany(as[ 1 ], bs)), bs.map(b => relate(as[ 1 ], b)));
+        assert.equal(isPrepared(as[ 1 ]), false); // prepared only for the call
+        assert.deepEqual(relateMany([], []), new Uint8Array());
+
+        const errors = new Uint8Array(2);
+        const matrices = relateMany([ point([ 0, 0 ]), fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)') ], [ point([ 0, 0 ]), point([ 0, 0 ]) ], { errors });
+        assert.deepEqual(errors, new Uint8Array([ 0, 1 ]));
+        assert.deepEqual(decode(matrices), [ '0FFFFFFF2', '\0'.repeat(9) ]);
+    });
+
+    it('should handle empty and large input arrays', () => {
+        assert.deepEqual(intersectionMany([], []), []);
+        assert.deepEqual(distanceMany(point([ 0, 0 ]), []), new Float64Array());
+
+        const bs = Array.from({ length: 3_000 }, (_, i) => point([ i % 100, Math.floor(i / 100) ])); // larger than reusable buffer
+        const a = point([ 50, 15 ]);
+        assert.deepEqual(distanceMany(a, bs), Float64Array.from(bs, b => distance(a, b)));
+    });
+
+    it('should throw when arrays have different lengths', () => {
+        assert.throws(() => unionMany([ point([ 0, 0 ]) ], [ point([ 0, 0 ]), point([ 1, 1 ]) ]), {
+            name: 'GEOSError',
+            message: 'Arrays must have the same length, got 1 and 2',
+        });
+    });
+
+    it('should throw on first failure or report failures in errors array', () => {
+        const curve = fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)');
+        const as = [ point([ 0, 0 ]), curve, point([ 1, 1 ]) ];
+        const b = point([ 3, 4 ]);
+
+        assert.throws(() => intersectionMany(as, b), {
+            name: 'GEOSError::UnsupportedOperationException',
+        });
+        assert.throws(() => distanceMany(as, b), {
+            name: 'GEOSError::UnsupportedOperationException',
+        });
+
+        const errors = new Uint8Array(3);
+        const geometries = intersectionMany(as, b, { errors });
+        assert.deepEqual(errors, new Uint8Array([ 0, 1, 0 ]));
+        assert.equal(geometries[ 1 ], null);
+        assert.equal(toWKT(geometries[ 0 ]!), 'POINT EMPTY');
+
+        errors.fill(7);
+        assert.deepEqual(distanceMany(as, b, { errors }), new Float64Array([ 5, NaN, Math.hypot(2, 3) ]));
+        assert.deepEqual(errors, new Uint8Array([ 0, 1, 0 ]));
+
+        // regular error handling is restored
+        assert.throws(() => intersection(curve, b), {
+            name: 'GEOSError::UnsupportedOperationException',
+        });
+    });
+
+    it('should restore regular error handling when batch call is aborted by JS exception', () => {
+        const curve = fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)');
+        const b = point([ 3, 4 ]);
+        const pairwise = geos.pairwise;
+        const geos_pairwise = mock.method(geos, 'pairwise', (...args: Parameters<typeof pairwise>) => {
+            pairwise(...args); // leaves the capture handler installed, like an exception thrown from a Wasm import would
+            throw new Error('aborted');
+        });
+        try {
+            assert.throws(() => distanceMany([ curve ], b, { errors: new Uint8Array(1) }), { message: 'aborted' });
+        } finally {
+            geos_pairwise.mock.restore();
+        }
+
+        assert.throws(() => intersection(curve, b), {
+            name: 'GEOSError::UnsupportedOperationException',
+        });
+    });
+
+    it('should throw when errors array is too short', () => {
+        assert.throws(() => distanceMany(point([ 0, 0 ]), [ point([ 1, 1 ]) ], { errors: new Uint8Array() }), {
+            name: 'GEOSError',
+            message: 'Errors array is too short, expected at least 1 elements',
+        });
+    });
+
+});
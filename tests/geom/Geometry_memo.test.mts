@@ -0,0 +1,81 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { lineString, polygon } from '../../src/helpers/helpers.mjs';
+import { area } from '../../src/measurement/area.mjs';
+import { bounds } from '../../src/measurement/bounds.mjs';
+import { length } from '../../src/measurement/length.mjs';
+import { isSimple } from '../../src/predicates/isSimple.mjs';
+import { isValid, isValidOrThrow } from '../../src/predicates/isValid.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('Geometry memo', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should compute unary results once', () => {
+        const a = polygon([ [ [ 0, 0 ], [ 2, 0 ], [ 2, 2 ], [ 0, 0 ] ] ]);
+        const GEOSArea = mock.method(geos, 'GEOSArea');
+        const GEOSLength = mock.method(geos, 'GEOSLength');
+        const GEOSisSimple = mock.method(geos, 'GEOSisSimple');
+        const GEOSisValidDetail = mock.method(geos, 'GEOSisValidDetail');
+        const GEOSGeom_getExtent = mock.method(geos, 'GEOSGeom_getExtent');
+        try {
+            for (let i = 0; i < 3; i++) {
+                assert.equal(area(a), 2);
+                assert.equal(length(a), 4 + Math.SQRT2 * 2);
+                assert.equal(isSimple(a), true);
+                assert.equal(isValid(a), true);
+                isValidOrThrow(a);
+                assert.deepEqual(bounds(a), [ 0, 0, 2, 2 ]);
+            }
+            assert.equal(GEOSArea.mock.callCount(), 1);
+            assert.equal(GEOSLength.mock.callCount(), 1);
+            assert.equal(GEOSisSimple.mock.callCount(), 1);
+            assert.equal(GEOSisValidDetail.mock.callCount(), 1);
+            assert.equal(GEOSGeom_getExtent.mock.callCount(), 1);
+
+            // separate entry per `isInvertedRingValid` option
+            assert.equal(isValid(a, { isInvertedRingValid: true }), true);
+            assert.equal(GEOSisValidDetail.mock.callCount(), 2);
+        } finally {
+            GEOSArea.mock.restore();
+            GEOSLength.mock.restore();
+            GEOSisSimple.mock.restore();
+            GEOSisValidDetail.mock.restore();
+            GEOSGeom_getExtent.mock.restore();
+        }
+    });
+
+    it('should return a copy of memoized bounds', () => {
+        const a = lineString([ [ 0, 0 ], [ 1, 1 ] ]);
+        bounds(a)[ 0 ] = 100;
+        assert.deepEqual(bounds(a), [ 0, 0, 1, 1 ]);
+    });
+
+    it('should still throw on memoized invalid geometry', () => {
+        const a = polygon([ [ [ 0, 0 ], [ 1, 1 ], [ 1, 0 ], [ 0, 1 ], [ 0, 0 ] ] ]);
+        assert.equal(isValid(a), false);
+        assert.throws(() => isValidOrThrow(a), { message: 'Self-intersection' });
+        assert.throws(() => isValidOrThrow(a), { message: 'Self-intersection' });
+    });
+
+    it('should invalidate memo on in-place mutation', () => {
+        const a = polygon([ [ [ 0, 0 ], [ 2, 0 ], [ 2, 2 ], [ 0, 0 ] ] ]);
+        assert.equal(area(a), 2);
+        const GEOSArea = mock.method(geos, 'GEOSArea');
+        try {
+            a.normalize();
+            assert.equal(area(a), 2);
+            a.orientPolygons('ccw');
+            assert.equal(area(a), 2);
+            assert.equal(GEOSArea.mock.callCount(), 2);
+        } finally {
+            GEOSArea.mock.restore();
+        }
+    });
+
+});
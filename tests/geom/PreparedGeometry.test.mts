@@ -3,9 +3,14 @@ import { before, describe, it, mock } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
 import { P_POINTER, POINTER } from '../../src/core/symbols.mjs';
 import { GeometryRef } from '../../src/geom/Geometry.mjs';
-import { prepare, unprepare } from '../../src/geom/PreparedGeometry.mjs';
-import { point } from '../../src/helpers/helpers.mjs';
+import { autoPrepare, prepare, unprepare } from '../../src/geom/PreparedGeometry.mjs';
+import { box, point } from '../../src/helpers/helpers.mjs';
+import { isPrepared } from '../../src/predicates/isPrepared.mjs';
+import { contains } from '../../src/spatial-predicates/contains.mjs';
+import { distance } from '../../src/measurement/distance.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
 import { fromWKT } from '../../src/io/WKT.mjs';
+import { freeAll } from '../../src/geom/scope.mjs';
 import { geos } from '../../src/core/geos.mjs';
 
 
@@ -95,4 +100,95 @@ describe('PreparedGeometry', () => {
         });
     });
 
+    describe('autoPrepare', () => {
+
+        it('should prepare geometry after `minUses` uses', () => {
+            autoPrepare({ minUses: 3 });
+            try {
+                const a = box([ 0, 0, 10, 10 ]), b = point([ 1, 1 ]);
+                assert.equal(contains(a, b), true);
+                assert.equal(isPrepared(a), false);
+                assert.equal(distance(a, b), 0);
+                assert.equal(isPrepared(a), false);
+                assert.equal(contains(a, b), true);
+                assert.equal(isPrepared(a), true);
+                assert.equal(isPrepared(b), false); // only the first argument is counted
+            } finally {
+                autoPrepare(false);
+            }
+        });
+
+        it('should prepare large geometry on first use', () => {
+            autoPrepare({ minVertices: 100 });
+            try {
+                const a = buffer(point([ 0, 0 ]), 10, { quadrantSegments: 100 }); // 401 vertices
+                const b = box([ 0, 0, 10, 10 ]);
+                contains(a, point([ 1, 1 ]));
+                contains(b, point([ 1, 1 ]));
+                assert.equal(isPrepared(a), true);
+                assert.equal(isPrepared(b), false);
+            } finally {
+                autoPrepare(false);
+            }
+        });
+
+        it('should unprepare least recently used geometries above the limit', () => {
+            autoPrepare({ minUses: 1, maxPreparedVertices: 10 });
+            try {
+                const manual = prepare(box([ 0, 0, 1, 1 ]));
+                const [ a, b, c ] = [ box([ 0, 0, 2, 2 ]), box([ 0, 0, 3, 3 ]), box([ 0, 0, 4, 4 ]) ]; // 5 vertices each
+                const pt = point([ 1, 1 ]);
+                contains(a, pt);
+                contains(b, pt);
+                assert.deepEqual([ a, b ].map(isPrepared), [ true, true ]);
+                contains(a, pt); // `b` is now the least recently used
+                contains(c, pt);
+                assert.deepEqual([ a, b, c ].map(isPrepared), [ true, false, true ]);
+                contains(manual, pt);
+                assert.equal(isPrepared(manual), true); // manually prepared geometries are never unprepared
+            } finally {
+                autoPrepare(false);
+            }
+        });
+
+        it('should stop counting freed and unprepared geometries towards the limit', () => {
+            autoPrepare({ minUses: 1, maxPreparedVertices: 10 });
+            try {
+                const pt = point([ 1, 1 ]);
+                const [ a, b, c ] = [ box([ 0, 0, 2, 2 ]), box([ 0, 0, 3, 3 ]), box([ 0, 0, 4, 4 ]) ]; // 5 vertices each
+                contains(a, pt);
+                contains(b, pt);
+                assert.equal(geos.a_p!.preparedVertices, 10);
+                a.free();
+                unprepare(b);
+                assert.equal(geos.a_p!.preparedVertices, 0);
+                assert.equal(geos.a_p!.prepared.size, 0);
+                const d = box([ 0, 0, 5, 5 ]);
+                contains(c, pt);
+                contains(d, pt);
+                assert.deepEqual([ c, d ].map(isPrepared), [ true, true ]); // nothing evicted
+                freeAll([ c, d ]);
+                assert.equal(geos.a_p!.preparedVertices, 0);
+            } finally {
+                autoPrepare(false);
+            }
+        });
+
+        it('should not count uses when disabled', () => {
+            const a = box([ 0, 0, 10, 10 ]);
+            for (let i = 0; i < 10; i++) {
+                contains(a, point([ 1, 1 ]));
+            }
+            assert.equal(isPrepared(a), false);
+        });
+
+        it('should throw on invalid options', () => {
+            assert.throws(() => autoPrepare({ minUses: 0 }), {
+                name: 'GEOSError',
+                message: 'Invalid auto prepare options',
+            });
+        });
+
+    });
+
 });
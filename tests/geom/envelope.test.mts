@@ -0,0 +1,160 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { fromWKT, toWKT } from '../../src/io/WKT.mjs';
+import { fromGeoJSON } from '../../src/io/GeoJSON.mjs';
+import { bounds } from '../../src/measurement/bounds.mjs';
+import type { JSON_Geometry } from '../../src/geom/types/JSON.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { intersects } from '../../src/spatial-predicates/intersects.mjs';
+import { contains, within } from '../../src/spatial-predicates/contains.mjs';
+import { distanceWithin } from '../../src/predicates/distanceWithin.mjs';
+import { envelopeOf } from '../../src/geom/envelope.mjs';
+import { ENVELOPE } from '../../src/core/symbols.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('Geometry envelope', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should capture envelope of geosified geometries', () => {
+        const a = lineString([ [ 0, 5 ], [ 3, 1 ], [ -2, 4 ] ]);
+        assert.deepEqual(Array.from(a[ ENVELOPE ]!), [ -2, 1, 3, 5 ]);
+        const b = point([ 7, 8 ]);
+        assert.deepEqual(Array.from(b[ ENVELOPE ]!), [ 7, 8, 7, 8 ]);
+    });
+
+    it('should capture the same envelope as bounds for every geometry type', () => {
+        const geometries: JSON_Geometry[] = [
+            { type: 'Point', coordinates: [ 3, -4 ] },
+            { type: 'Point', coordinates: [ 3, -4, 9 ] },
+            { type: 'MultiPoint', coordinates: [ [ 3, -4 ], [ -1, 7 ], [ 2, 2 ] ] },
+            { type: 'LineString', coordinates: [ [ 0, 5 ], [ 3, 1, 8 ], [ -2, 4 ] ] },
+            { type: 'MultiLineString', coordinates: [ [ [ 0, 5 ], [ 3, 1 ] ], [ [ -2, 4 ], [ 9, -9 ] ] ] },
+            { type: 'Polygon', coordinates: [ [ [ 0, 0 ], [ 10, 0 ], [ 10, 8 ], [ 0, 0 ] ], [ [ 2, 1 ], [ 8, 1 ], [ 8, 6 ], [ 2, 1 ] ] ] },
+            { type: 'MultiPolygon', coordinates: [ [ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ], [ [ [ -5, -6 ], [ -4, -6 ], [ -4, -5 ], [ -5, -6 ] ] ] ] },
+            {
+                type: 'GeometryCollection', geometries: [
+                    { type: 'Point', coordinates: [ 20, 30 ] },
+                    { type: 'GeometryCollection', geometries: [ { type: 'LineString', coordinates: [ [ -1, -2 ], [ 0, 0 ] ] } ] },
+                    { type: 'Polygon', coordinates: [] },
+                ],
+            },
+        ];
+        // both geosify paths: single geometries and feature collections
+        const create = (geometries: JSON_Geometry[]) => [
+            ...geometries.map(g => fromGeoJSON(g)),
+            ...fromGeoJSON({
+                type: 'FeatureCollection',
+                features: geometries.map(geometry => ({ type: 'Feature' as const, geometry, properties: null })),
+            }),
+        ];
+        const created = create(geometries);
+        for (const geometry of created) {
+            assert.deepEqual(Array.from(geometry[ ENVELOPE ]!), bounds(geometry), geometry.type);
+            assert.deepEqual(Array.from(envelopeOf(fromWKT(toWKT(geometry)))!), bounds(geometry), geometry.type); // computed on first use
+        }
+
+        const empty: JSON_Geometry[] = [
+            { type: 'Point', coordinates: [] },
+            { type: 'MultiPoint', coordinates: [] },
+            { type: 'LineString', coordinates: [] },
+            { type: 'MultiLineString', coordinates: [] },
+            { type: 'Polygon', coordinates: [] },
+            { type: 'MultiPolygon', coordinates: [] },
+            { type: 'GeometryCollection', geometries: [] },
+            { type: 'GeometryCollection', geometries: [ { type: 'Point', coordinates: [] } ] },
+        ];
+        for (const geometry of create(empty)) {
+            assert.equal(geometry[ ENVELOPE ], null, geometry.type);
+            assert.throws(() => bounds(geometry), { name: 'GEOSError' });
+        }
+
+        const curved: JSON_Geometry[] = [
+            { type: 'CircularString', coordinates: [ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ] ] },
+            { type: 'CompoundCurve', segments: [ { type: 'CircularString', coordinates: [ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ] ] }, { type: 'LineString', coordinates: [ [ 2, 0 ], [ 0, 0 ] ] } ] },
+            { type: 'GeometryCollection', geometries: [ { type: 'Point', coordinates: [ 5, 5 ] }, { type: 'CircularString', coordinates: [ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ] ] } ] },
+        ];
+        for (const geometry of create(curved)) {
+            assert.equal(geometry[ ENVELOPE ], null, geometry.type); // left to GEOS
+        }
+    });
+
+    it('should not capture envelope of empty geometries', () => {
+        assert.equal(point([])[ ENVELOPE ], null);
+        assert.equal(polygon([])[ ENVELOPE ], null);
+    });
+
+    it('should share envelope with clone and drop it on mutation', () => {
+        const a = polygon([ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ]);
+        const b = a.clone();
+        assert.equal(b[ ENVELOPE ], a[ ENVELOPE ]);
+        a.normalize();
+        assert.equal(a[ ENVELOPE ], undefined);
+        b.orientPolygons();
+        assert.equal(b[ ENVELOPE ], undefined);
+    });
+
+    it('should reject bbox-disjoint pairs without calling GEOS', () => {
+        const a = polygon([ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ]);
+        const b = point([ 5, 5 ]);
+        const GEOSIntersects = mock.method(geos, 'GEOSIntersects');
+        const GEOSContains = mock.method(geos, 'GEOSContains');
+        const GEOSDistanceWithin = mock.method(geos, 'GEOSDistanceWithin');
+        try {
+            assert.equal(intersects(a, b), false);
+            assert.equal(contains(a, b), false);
+            assert.equal(within(b, a), false);
+            assert.equal(distanceWithin(a, b, 5), false);
+            assert.equal(GEOSIntersects.mock.callCount(), 0);
+            assert.equal(GEOSContains.mock.callCount(), 0);
+            assert.equal(GEOSDistanceWithin.mock.callCount(), 0);
+
+            // within distance, decision left to GEOS
+            assert.equal(distanceWithin(a, b, 6), true);
+            assert.equal(GEOSDistanceWithin.mock.callCount(), 1);
+        } finally {
+            GEOSIntersects.mock.restore();
+            GEOSContains.mock.restore();
+            GEOSDistanceWithin.mock.restore();
+        }
+    });
+
+    it('should compute envelope of non-GeoJSON geometries on first use', () => {
+        const a = fromWKT('POLYGON ((0 0, 1 0, 1 1, 0 0))');
+        const b = buffer(point([ 5, 5 ]), 1);
+        assert.equal(a[ ENVELOPE ], undefined);
+        assert.equal(b[ ENVELOPE ], undefined);
+        const GEOSIntersects = mock.method(geos, 'GEOSIntersects');
+        const geom_envelope = mock.method(geos, 'geom_envelope');
+        try {
+            assert.equal(intersects(a, b), false);
+            assert.equal(intersects(a, b), false);
+            assert.equal(GEOSIntersects.mock.callCount(), 0);
+            assert.equal(geom_envelope.mock.callCount(), 2); // once per geometry
+            assert.deepEqual(Array.from(a[ ENVELOPE ]!), [ 0, 0, 1, 1 ]);
+            assert.equal(fromWKT('POINT EMPTY')[ ENVELOPE ], undefined);
+        } finally {
+            GEOSIntersects.mock.restore();
+            geom_envelope.mock.restore();
+        }
+    });
+
+    it('should leave geometries without known envelope to GEOS', () => {
+        const a = fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)');
+        const b = point([ 5, 5 ]);
+        const GEOSIntersects = mock.method(geos, 'GEOSIntersects', () => 0);
+        try {
+            assert.equal(intersects(a, b), false);
+            assert.equal(a[ ENVELOPE ], null);
+            assert.equal(GEOSIntersects.mock.callCount(), 1);
+        } finally {
+            GEOSIntersects.mock.restore();
+        }
+    });
+
+});
@@ -0,0 +1,141 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import type { Geometry } from '../../src/geom/Geometry.mjs';
+import { point } from '../../src/helpers/helpers.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { union } from '../../src/operations/union.mjs';
+import { prepare } from '../../src/geom/PreparedGeometry.mjs';
+import { freeAll, scope } from '../../src/geom/scope.mjs';
+import { toWKT } from '../../src/io/WKT.mjs';
+import { P_POINTER } from '../../src/core/symbols.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('scope', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should free intermediate geometries in a single Wasm call', () => {
+        const a = point([ 0, 0 ]), b = point([ 2, 0 ]);
+        let ab: Geometry | undefined, bb: Geometry | undefined;
+        const geoms_destroy = mock.method(geos, 'geoms_destroy');
+        try {
+            const result = scope(() => {
+                ab = buffer(a, 1);
+                bb = prepare(buffer(b, 1));
+                return union(ab, bb);
+            });
+            assert.equal(result.type, 'Polygon');
+            assert.equal(result.detached, undefined);
+            assert.equal(ab!.detached, true);
+            assert.equal(bb!.detached, true);
+            assert.equal(a.detached, undefined); // created outside the scope
+            assert.equal(geoms_destroy.mock.callCount(), 1);
+            assert.equal(geoms_destroy.mock.calls[ 0 ].arguments[ 1 ], 2);
+        } finally {
+            geoms_destroy.mock.restore();
+        }
+    });
+
+    it('should keep returned arrays and explicitly kept geometries', () => {
+        let kept: Geometry | undefined, dropped: Geometry | undefined;
+        const [ x, [ y ] ] = scope((keep) => {
+            kept = keep(point([ 1, 1 ]));
+            dropped = point([ 2, 2 ]);
+            return [ point([ 3, 3 ]), [ point([ 4, 4 ]) ] ] as const;
+        });
+        assert.equal(toWKT(kept!), 'POINT (1 1)');
+        assert.equal(toWKT(x), 'POINT (3 3)');
+        assert.equal(toWKT(y), 'POINT (4 4)');
+        assert.equal(dropped!.detached, true);
+    });
+
+    it('should keep geometries returned in plain objects', () => {
+        let dropped: Geometry | undefined;
+        let wrapped: Geometry | undefined;
+        const { a, nested: { b, list: [ c ] } } = scope(() => {
+            dropped = point([ 0, 0 ]);
+            const object = Object.create(null) as { a: Geometry, nested?: unknown };
+            object.a = point([ 1, 1 ]);
+            object.nested = { b: point([ 2, 2 ]), list: [ point([ 3, 3 ]) ], self: object };
+            return object as { a: Geometry, nested: { b: Geometry, list: Geometry[] } };
+        });
+        assert.equal(toWKT(a), 'POINT (1 1)');
+        assert.equal(toWKT(b), 'POINT (2 2)');
+        assert.equal(toWKT(c), 'POINT (3 3)');
+        assert.equal(dropped!.detached, true);
+
+        // instances of other classes are not walked
+        scope(() => new Map([ [ 'd', wrapped = point([ 4, 4 ]) ] ]));
+        assert.equal(wrapped!.detached, true);
+    });
+
+    it('should hand escaping geometries to the outer scope', () => {
+        let inner: Geometry | undefined;
+        scope(() => {
+            inner = scope(() => point([ 1, 1 ]));
+            assert.equal(inner.detached, undefined);
+        });
+        assert.equal(inner!.detached, true);
+    });
+
+    it('should free geometries when the function throws', () => {
+        let pt: Geometry | undefined;
+        assert.throws(() => scope(() => {
+            pt = point([ 1, 1 ]);
+            throw new Error('oops');
+        }), { message: 'oops' });
+        assert.equal(pt!.detached, true);
+
+        // tracking is stopped
+        assert.equal(point([ 0, 0 ]).detached, undefined);
+    });
+
+    it('should skip geometries freed manually', () => {
+        const geoms_destroy = mock.method(geos, 'geoms_destroy');
+        try {
+            scope(() => {
+                point([ 1, 1 ]).free();
+            });
+            assert.equal(geoms_destroy.mock.callCount(), 0);
+        } finally {
+            geoms_destroy.mock.restore();
+        }
+    });
+
+});
+
+
+describe('freeAll', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should free geometries and prepared geometries in a single Wasm call', () => {
+        const geometries = Array.from({ length: 3000 }, (_, i) => point([ i, i ])); // larger than reusable buffer
+        prepare(geometries[ 1 ]);
+        geometries[ 2 ].free();
+        const geoms_destroy = mock.method(geos, 'geoms_destroy');
+        const GEOSGeom_destroy = mock.method(geos, 'GEOSGeom_destroy');
+        try {
+            freeAll([ ...geometries, geometries[ 0 ] ]);
+            assert.equal(geoms_destroy.mock.callCount(), 1);
+            assert.equal(geoms_destroy.mock.calls[ 0 ].arguments[ 1 ], 2999); // without detached and duplicated
+            assert.equal(GEOSGeom_destroy.mock.callCount(), 0);
+            assert.ok(geometries.every(g => g.detached));
+            assert.equal(geometries[ 1 ][ P_POINTER ], undefined);
+        } finally {
+            geoms_destroy.mock.restore();
+            GEOSGeom_destroy.mock.restore();
+        }
+    });
+
+    it('should handle empty input', () => {
+        freeAll([]);
+    });
+
+});
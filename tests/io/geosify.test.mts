@@ -3,9 +3,14 @@ import { before, describe, it, mock } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
 import type { JSON_Feature, JSON_Geometry } from '../../src/geom/types/JSON.mjs';
 import type { CoordinateType } from '../../src/geom/Geometry.mjs';
+import type { Point } from '../../src/geom/types/Point.mjs';
 import { geosifyFeatures, geosifyGeometry } from '../../src/io/geosify.mjs';
 import { bounds } from '../../src/measurement/bounds.mjs';
 import { toWKT } from '../../src/io/WKT.mjs';
+import { scratchBufferPolicy, scratchBufferStats } from '../../src/other/scratchBuffer.mjs';
+import { multiPoint } from '../../src/helpers/helpers.mjs';
+import { freeAll } from '../../src/geom/scope.mjs';
+import { POINTER } from '../../src/core/symbols.mjs';
 import { geos } from '../../src/core/geos.mjs';
 
 
@@ -1193,7 +1198,88 @@ describe('geosify - GeoJSON to GEOS', () => {
         );
     });
 
-    it('should create tmp buffer when default one is too small', () => {
+    it('should share identical geometries in dedup mode', () => {
+        const boundary: JSON_Geometry = { type: 'Polygon', coordinates: [ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ] };
+        const features: JSON_Feature<JSON_Geometry, { n: number }>[] = [
+            { type: 'Feature', geometry: boundary, properties: { n: 0 } },
+            { type: 'Feature', geometry: { type: 'Point', coordinates: [ 0, 0 ] }, properties: { n: 1 } },
+            { type: 'Feature', geometry: structuredClone(boundary), properties: { n: 2 } },
+            { type: 'Feature', geometry: boundary, properties: { n: 3 } },
+            { type: 'Feature', geometry: { type: 'Point', coordinates: [ 0, 0, 1 ] }, properties: { n: 4 } },
+        ];
+
+        const geometries = geosifyFeatures(features, 'XYZM');
+        assert.equal(new Set(geometries).size, 5);
+
+        const GEOSGeom_destroy = mock.method(geos, 'GEOSGeom_destroy');
+        try {
+            const shared = geosifyFeatures(features, 'XYZM', true);
+            assert.equal(new Set(shared).size, 5);
+            assert.equal(shared[ 0 ][ POINTER ], shared[ 2 ][ POINTER ]);
+            assert.equal(shared[ 0 ][ POINTER ], shared[ 3 ][ POINTER ]);
+            assert.equal(new Set(shared.map(g => g[ POINTER ])).size, 3);
+            assert.deepEqual(shared.map(g => g.props!.n), [ 0, 1, 2, 3, 4 ]);
+            assert.deepEqual(shared.map(g => toWKT(g)), geometries.map(g => toWKT(g)));
+            assert.equal(GEOSGeom_destroy.mock.callCount(), 2); // duplicates are freed right away
+        } finally {
+            GEOSGeom_destroy.mock.restore();
+        }
+    });
+
+    it('should keep id and props of each feature in dedup mode', () => {
+        const geometry: JSON_Geometry = { type: 'LineString', coordinates: [ [ 0, 0 ], [ 1, 1 ] ] };
+        const [ a, b ] = geosifyFeatures<{ name: string }>([
+            { type: 'Feature', id: 'a', geometry, properties: { name: 'A' } },
+            { type: 'Feature', id: 'b', geometry, properties: { name: 'B' } },
+        ], 'XYZM', true);
+        assert.notEqual(a, b);
+        assert.equal(a[ POINTER ], b[ POINTER ]);
+        assert.deepEqual([ a.id, a.props ], [ 'a', { name: 'A' } ]);
+        assert.deepEqual([ b.id, b.props ], [ 'b', { name: 'B' } ]);
+
+        const GEOSGeom_destroy = mock.method(geos, 'GEOSGeom_destroy');
+        try {
+            a.free(); // `b` still uses the shared geometry
+            assert.equal(a.detached, true);
+            assert.equal(b.detached, undefined);
+            assert.equal(GEOSGeom_destroy.mock.callCount(), 0);
+            assert.equal(toWKT(b), 'LINESTRING (0 0, 1 1)');
+
+            b.free();
+            assert.equal(GEOSGeom_destroy.mock.callCount(), 1);
+        } finally {
+            GEOSGeom_destroy.mock.restore();
+        }
+    });
+
+    it('should destroy shared geometry once all its refs are freed at once', () => {
+        const geometry: JSON_Geometry = { type: 'Point', coordinates: [ 1, 2 ] };
+        const features = Array.from({ length: 3 }, (_, i): JSON_Feature => ({ type: 'Feature', id: i, geometry, properties: null }));
+
+        const [ a, b, c ] = geosifyFeatures(features, 'XYZM', true);
+        const geoms_destroy = mock.method(geos, 'geoms_destroy');
+        try {
+            freeAll([ a, b ]);
+            const ptr = geoms_destroy.mock.calls[ 0 ].arguments[ 0 ] / 4;
+            assert.deepEqual(Array.from(geos.U32.subarray(ptr, ptr + 2)), [ 0, 0 ]); // `c` still uses the shared geometry
+            assert.equal(toWKT(c), 'POINT (1 2)');
+
+            const collection = multiPoint([ c as Point ], { consume: true });
+            assert.equal(c.detached, true);
+            assert.equal(toWKT(collection), 'MULTIPOINT ((1 2))');
+        } finally {
+            geoms_destroy.mock.restore();
+        }
+
+        const [ d, e ] = geosifyFeatures(features, 'XYZM', true);
+        const collection = multiPoint([ d as Point ], { consume: true }); // `e` still uses the shared geometry
+        assert.equal(toWKT(e), 'POINT (1 2)');
+        e.free();
+        assert.equal(toWKT(collection), 'MULTIPOINT ((1 2))');
+    });
+
+    it('should use scratch buffer when default one is too small', () => {
+        scratchBufferPolicy({}); // frees scratch buffer of the previous tests
         const malloc = mock.method(geos, 'malloc');
         const free = mock.method(geos, 'free');
 
@@ -1213,11 +1299,10 @@ describe('geosify - GeoJSON to GEOS', () => {
         })), 'XYZM');
 
         assert.equal(malloc.mock.callCount(), 1);
-        const mallocCall = malloc.mock.calls[ 0 ];
-        assert.deepEqual(mallocCall.arguments, [ 20012 ]); // (buffer meta) 8 + (headers) 1000*4 + (coords) 1000*2*8 + 4 bytes for optional alignment
-        assert.equal(free.mock.callCount(), 1);
-        const freeCall = free.mock.calls[ 0 ];
-        assert.deepEqual(freeCall.arguments, [ mallocCall.result ]);
+        // (buffer meta) 8 + (headers) 1000*4 + (coords) 1000*2*8 + 4 bytes for optional alignment + (envelopes) 1000*4*8 = 52012,
+        // rounded up to 64KB
+        assert.deepEqual(malloc.mock.calls[ 0 ].arguments, [ 65536 ]);
+        assert.equal(free.mock.callCount(), 0); // kept for the next calls
 
         geosifyFeatures(Array.from({ length: 1000 }, () => ({
             type: 'Feature',
@@ -1225,12 +1310,36 @@ describe('geosify - GeoJSON to GEOS', () => {
             properties: null,
         })), 'XYZM');
 
-        assert.equal(malloc.mock.callCount(), 2);
-        const mallocCall2 = malloc.mock.calls[ 1 ];
-        assert.deepEqual(mallocCall2.arguments, [ 28012 ]); // (buffer meta) 8 + (headers) 1000*4 + (coords) 1000*3*8 + 4 bytes for optional alignment
-        assert.equal(free.mock.callCount(), 2);
-        const freeCall2 = free.mock.calls[ 1 ];
-        assert.deepEqual(freeCall2.arguments, [ mallocCall2.result ]);
+        // 8 + 1000*4 + 1000*3*8 + 4 + 1000*4*8 = 60012 fits in the scratch buffer
+        assert.equal(malloc.mock.callCount(), 1);
+        assert.equal(free.mock.callCount(), 0);
+        assert.equal(scratchBufferStats().size, 65536);
+
+        malloc.mock.restore();
+        free.mock.restore();
+    });
+
+    it('should create tmp buffer when scratch buffer is disabled', () => {
+        scratchBufferPolicy({ maximum: 0 });
+        const malloc = mock.method(geos, 'malloc');
+        const free = mock.method(geos, 'free');
+        try {
+            geosifyFeatures(Array.from({ length: 1000 }, () => ({
+                type: 'Feature',
+                geometry: { type: 'Point', coordinates: [ Math.random(), Math.random() ] },
+                properties: null,
+            })), 'XYZM');
+
+            assert.equal(malloc.mock.callCount(), 1);
+            const mallocCall = malloc.mock.calls[ 0 ];
+            assert.deepEqual(mallocCall.arguments, [ 52012 ]);
+            assert.equal(free.mock.callCount(), 1);
+            assert.deepEqual(free.mock.calls[ 0 ].arguments, [ mallocCall.result ]);
+        } finally {
+            malloc.mock.restore();
+            free.mock.restore();
+            scratchBufferPolicy({});
+        }
     });
 
 });
@@ -5,6 +5,7 @@ import type { CoordinateType } from '../../src/geom/Geometry.mjs';
 import type { JSON_Geometry } from '../../src/geom/types/JSON.mjs';
 import { jsonifyFeatures, jsonifyGeometry } from '../../src/io/jsonify.mjs';
 import { fromWKT } from '../../src/io/WKT.mjs';
+import { scratchBufferPolicy } from '../../src/other/scratchBuffer.mjs';
 import { geos } from '../../src/core/geos.mjs';
 
 
@@ -1209,47 +1210,68 @@ describe('jsonify - GEOS to GeoJSON', () => {
         ]);
     });
 
-    it('should create tmp [out] buffer when default one is too small', () => {
+    it('should retry with scratch buffer when default one is too small for [out]', () => {
+        scratchBufferPolicy({}); // frees scratch buffer of the previous tests
         const malloc = mock.method(geos, 'malloc');
         const free = mock.method(geos, 'free');
+        const jsonify_geoms = mock.method(geos, 'jsonify_geoms');
+        try {
+            jsonifyGeometry(fromWKT('POINT Z (19.8471 50.06 271)'));
 
-        jsonifyGeometry(fromWKT('POINT Z (19.8471 50.06 271)'));
+            assert.equal(malloc.mock.callCount(), 0);
+            assert.equal(free.mock.callCount(), 0);
+            assert.equal(jsonify_geoms.mock.callCount(), 1);
 
-        assert.equal(malloc.mock.callCount(), 0);
-        assert.equal(free.mock.callCount(), 0);
+            const bigGeometry = fromWKT(`MULTIPOINT (${
+                Array.from({ length: 1100 }, () => `(${Math.random()} ${Math.random()})`).join(', ')
+            })`);
 
-        const bigGeometry = fromWKT(`MULTIPOINT (${
-            Array.from({ length: 1100 }, () => `(${Math.random()} ${Math.random()})`).join(', ')
-        })`);
+            malloc.mock.resetCalls();
+            jsonify_geoms.mock.resetCalls();
 
-        malloc.mock.resetCalls();
-        free.mock.resetCalls();
+            const a = jsonifyGeometry(bigGeometry);
 
-        jsonifyGeometry(bigGeometry);
+            assert.equal(malloc.mock.callCount(), 1); // scratch buffer
+            assert.equal(free.mock.callCount(), 0);
+            assert.equal(jsonify_geoms.mock.callCount(), 2); // retry with the size reported by Wasm
 
-        assert.equal(malloc.mock.callCount(), 0); // tmp [out] buffer was created by Wasm not by JS
-        assert.equal(free.mock.callCount(), 1); // tmp [out] buffer was freed by JS
+            const b = jsonifyGeometry(bigGeometry);
+
+            assert.deepEqual(b, a);
+            assert.equal(malloc.mock.callCount(), 1); // no new allocations
+            assert.equal(free.mock.callCount(), 0);
+            assert.equal(jsonify_geoms.mock.callCount(), 3); // scratch buffer is large enough at once
+        } finally {
+            malloc.mock.restore();
+            free.mock.restore();
+            jsonify_geoms.mock.restore();
+        }
     });
 
-    it('should create tmp [in] and [out] buffer when default one is too small', () => {
+    it('should create tmp [in] and [out] buffer when scratch buffer is disabled', () => {
+        scratchBufferPolicy({ maximum: 0 });
         const malloc = mock.method(geos, 'malloc');
         const free = mock.method(geos, 'free');
+        try {
+            jsonifyFeatures([ fromWKT(`POINT (${Math.random()} ${Math.random()})`) ]);
 
-        jsonifyFeatures([ fromWKT(`POINT (${Math.random()} ${Math.random()})`) ]);
-
-        assert.equal(malloc.mock.callCount(), 0);
-        assert.equal(free.mock.callCount(), 0);
+            assert.equal(malloc.mock.callCount(), 0);
+            assert.equal(free.mock.callCount(), 0);
 
-        jsonifyFeatures(Array.from({ length: 1100 }, () => (
-            fromWKT(`POINT (${Math.random()} ${Math.random()})`)
-        )));
+            jsonifyFeatures(Array.from({ length: 1100 }, () => (
+                fromWKT(`POINT (${Math.random()} ${Math.random()})`)
+            )));
 
-        assert.equal(malloc.mock.callCount(), 1);
-        const mallocCall = malloc.mock.calls[ 0 ];
-        assert.deepEqual(mallocCall.arguments, [ 4412 ]); // 12 + 1100*4
-        // 2 buffers where freed, tmp [in] buffer and tmp [out] buffer
-        assert.equal(free.mock.callCount(), 2);
-        assert.deepEqual(free.mock.calls[ 0 ].arguments, [ mallocCall.result ]);
+            // tmp [in] buffer, then tmp [in] + [out] buffer of the retry
+            assert.equal(malloc.mock.callCount(), 2);
+            assert.deepEqual(malloc.mock.calls[ 0 ].arguments, [ 4412 ]); // 12 + 1100*4
+            assert.equal(free.mock.callCount(), 2);
+            assert.deepEqual(free.mock.calls.map(c => c.arguments[ 0 ]), malloc.mock.calls.map(c => c.result));
+        } finally {
+            malloc.mock.restore();
+            free.mock.restore();
+            scratchBufferPolicy({});
+        }
     });
 
 });
@@ -1,7 +1,7 @@
 import assert from 'node:assert/strict';
 import { before, describe, it } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
-import { area } from '../../src/measurement/area.mjs';
+import { area, areaMany } from '../../src/measurement/area.mjs';
 import { fromWKT } from '../../src/io/WKT.mjs';
 
 
@@ -49,4 +49,17 @@ describe('area', () => {
         assert.equal(area(fromWKT('MULTISURFACE (((0 0, 1 0, 1 1, 0 1, 0 0)), CURVEPOLYGON (CIRCULARSTRING (10 10, 11 11, 12 10, 11 9, 10 10)))')), 1 + Math.PI);
     });
 
+    it('should return areas of many geometries', () => {
+        const wkts = [
+            'POINT (1 1)',
+            'POLYGON ((0 0, 0 1, 1 1, 1 0, 0 0))',
+            'POLYGON EMPTY',
+            'MULTIPOLYGON (((0 0, 0 1, 1 1, 1 0, 0 0)), ((2 2, 2 3, 3 3, 2 2)))',
+            'CURVEPOLYGON (CIRCULARSTRING (0 0, 1 1, 2 0, 1 -1, 0 0))',
+            'GEOMETRYCOLLECTION EMPTY',
+        ];
+        assert.deepEqual(areaMany(wkts.map(wkt => fromWKT(wkt))), new Float64Array([ 0, 1, NaN, 1.5, Math.PI, NaN ]));
+        assert.deepEqual(areaMany([]), new Float64Array());
+    });
+
 });
@@ -1,7 +1,7 @@
 import assert from 'node:assert/strict';
 import { before, describe, it } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
-import { bounds } from '../../src/measurement/bounds.mjs';
+import { bounds, boundsMany } from '../../src/measurement/bounds.mjs';
 import { fromWKT } from '../../src/io/WKT.mjs';
 
 
@@ -53,4 +53,24 @@ describe('bounds', () => {
         assert.throws(() => bounds(fromWKT('GEOMETRYCOLLECTION EMPTY')), expectedError);
     });
 
+    it('should return bounds of many geometries', () => {
+        const wkts = [
+            'POINT (0 1)',
+            'POINT EMPTY',
+            'POLYGON ((0 1, 7 6, 11 10, 0 1))',
+            'CIRCULARSTRING (0 0, 1 1, 2 0)',
+            'GEOMETRYCOLLECTION EMPTY',
+        ];
+        assert.deepEqual(boundsMany(wkts.map(wkt => fromWKT(wkt))), new Float64Array([
+            0, 1, 0, 1,
+            NaN, NaN, NaN, NaN,
+            0, 1, 11, 10,
+            0, 0, 2, 1,
+            NaN, NaN, NaN, NaN,
+        ]));
+        // larger than reusable buffer
+        const points = Array.from({ length: 1_000 }, (_, i) => fromWKT(`POINT (${i} ${-i})`));
+        assert.deepEqual(boundsMany(points), Float64Array.from(points.flatMap(p => bounds(p))));
+    });
+
 });
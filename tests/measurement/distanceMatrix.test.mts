@@ -0,0 +1,55 @@
+import assert from 'node:assert/strict';
+import { before, describe, it } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import type { Geometry } from '../../src/geom/Geometry.mjs';
+import { distance, distanceMatrix } from '../../src/measurement/distance.mjs';
+import { box, lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { fromWKT } from '../../src/io/WKT.mjs';
+
+
+describe('distanceMatrix', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    const expectedMatrix = (as: Geometry[], bs: Geometry[], maxDistance = Infinity): Float64Array => (
+        Float64Array.from(as.flatMap(a => bs.map(b => {
+            const d = distance(a, b);
+            return d > maxDistance ? Infinity : d;
+        })))
+    );
+
+    it('should return the same distances as single distance', () => {
+        const as = [ point([ 0, 0 ]), lineString([ [ 5, 0 ], [ 5, 10 ] ]), buffer(point([ 20, 20 ]), 5) ];
+        const bs = [ point([ 3, 4 ]), box([ 8, 8, 9, 9 ]), point([ 100, 100 ]), buffer(point([ 40, 0 ]), 10) ];
+        for (const prepared of [ true, false ]) {
+            assert.deepEqual(distanceMatrix(as, bs, { prepared }), expectedMatrix(as, bs));
+            assert.deepEqual(distanceMatrix(bs, as, { prepared }), expectedMatrix(bs, as));
+            assert.deepEqual(distanceMatrix(as, bs, { prepared, maxDistance: 10 }), expectedMatrix(as, bs, 10));
+        }
+    });
+
+    it('should return NaN for empty geometries', () => {
+        const matrix = distanceMatrix([ point([ 0, 0 ]), polygon([]) ], [ point([]), point([ 0, 1 ]) ]);
+        assert.deepEqual(matrix, new Float64Array([ NaN, 1, NaN, NaN ]));
+    });
+
+    it('should handle empty and large input arrays', () => {
+        assert.deepEqual(distanceMatrix([], [ point([ 0, 0 ]) ]), new Float64Array());
+        assert.deepEqual(distanceMatrix([ point([ 0, 0 ]) ], []), new Float64Array());
+
+        const as = Array.from({ length: 40 }, (_, i) => point([ i, 0 ]));
+        const bs = Array.from({ length: 30 }, (_, i) => point([ 0, i ])); // matrix larger than reusable buffer
+        assert.deepEqual(distanceMatrix(as, bs, { maxDistance: 20 }), expectedMatrix(as, bs, 20));
+    });
+
+    it('should throw on unsupported geometry type', () => {
+        const curve = fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)');
+        assert.throws(() => distanceMatrix([ point([ 0, 0 ]) ], [ point([ 1, 1 ]), curve ]), {
+            name: 'GEOSError::UnsupportedOperationException',
+        });
+    });
+
+});
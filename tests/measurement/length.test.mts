@@ -1,7 +1,7 @@
 import assert from 'node:assert/strict';
 import { before, describe, it } from 'node:test';
 import { initializeForTest } from '../tests-utils.mjs';
-import { length } from '../../src/measurement/length.mjs';
+import { length, lengthMany } from '../../src/measurement/length.mjs';
 import { fromWKT } from '../../src/io/WKT.mjs';
 
 
@@ -50,4 +50,14 @@ describe('length', () => {
         assert.equal(length(fromWKT('MULTISURFACE (((0 0, 1 0, 1 1, 0 1, 0 0)), CURVEPOLYGON (CIRCULARSTRING (10 10, 11 11, 12 10, 11 9, 10 10)))')), 4 + Math.PI * 2);
     });
 
+    it('should return lengths of many geometries', () => {
+        const wkts = [
+            'POINT (1 1)',
+            'LINESTRING (0 0, 3 4)',
+            'LINESTRING EMPTY',
+            'POLYGON ((0 0, 0 1, 1 1, 1 0, 0 0))',
+        ];
+        assert.deepEqual(lengthMany(wkts.map(wkt => fromWKT(wkt))), new Float64Array([ 0, 5, NaN, 4 ]));
+    });
+
 });
@@ -0,0 +1,76 @@
+import assert from 'node:assert/strict';
+import { before, describe, it } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { point, polygon } from '../../src/helpers/helpers.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { toWKT } from '../../src/io/WKT.mjs';
+import { prepare } from '../../src/geom/PreparedGeometry.mjs';
+import { beginArena, resetArena } from '../../src/other/arena.mjs';
+import { strTreeIndex } from '../../src/spatial-indexes/STRTree.mjs';
+import { pointGridIndex } from '../../src/spatial-indexes/PointGrid.mjs';
+import { P_POINTER } from '../../src/core/symbols.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('arena', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should throw when the build has no arena support', (t) => {
+        if (geos.arena_begin) {
+            return t.skip('build with arena support');
+        }
+        assert.throws(() => beginArena(), { name: 'GEOSError', message: 'Arena is not available in this build' });
+        assert.throws(() => resetArena(), { name: 'GEOSError', message: 'Arena is not active' });
+    });
+
+    it('should detach geometries created in the arena', (t) => {
+        if (!geos.arena_begin) {
+            return t.skip('build without arena support');
+        }
+        const outside = polygon([ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ]);
+        beginArena({ capacity: 16 * 1024 * 1024 });
+        assert.throws(() => beginArena(), { name: 'GEOSError', message: 'Arena is already active' });
+        const a = buffer(point([ 0, 0 ]), 1);
+        prepare(outside);
+        const wkt = toWKT(a);
+        const stats = resetArena();
+
+        assert.ok(wkt.startsWith('POLYGON'));
+        assert.equal(a.detached, true);
+        assert.equal(outside.detached, undefined);
+        assert.equal(outside[ P_POINTER ], undefined);
+        assert.equal(toWKT(outside), 'POLYGON ((0 0, 1 0, 1 1, 0 0))');
+        assert.ok(stats.allocations > 0);
+        assert.equal(stats.fallbacks, 0);
+    });
+
+    it('should keep query buffers of indexes built before the arena out of it', (t) => {
+        if (!geos.arena_begin) {
+            return t.skip('build without arena support');
+        }
+        const n = 10_000;
+        const coords = Float64Array.from({ length: n * 2 }, (_, i) => i % 2 ? Math.floor(i / 200) : (i / 2) % 100);
+        const tree = strTreeIndex(Array.from({ length: n }, (_, i) => point([ coords[ i * 2 ], coords[ i * 2 + 1 ] ])));
+        const grid = pointGridIndex(coords);
+
+        for (let cycle = 0; cycle < 2; cycle++) {
+            beginArena({ capacity: 16 * 1024 * 1024 });
+            // geometries allocated in the arena before the queries, overlapping any stale arena-backed buffer
+            const buffers = Array.from({ length: 100 }, (_, i) => buffer(point([ i, i ]), 1));
+            const expected = buffers.map(b => toWKT(b));
+            // queries grow the reusable buffers of the indexes
+            assert.equal(tree.queryBBox(-1, -1, 100, 100).length, n);
+            assert.equal(grid.queryBBox(-1, -1, 100, 100).length, n);
+            assert.equal(grid.nearest(50, 50, n).length, n);
+            assert.deepEqual(buffers.map(b => toWKT(b)), expected);
+            resetArena();
+        }
+
+        assert.equal(tree.queryBBox(-1, -1, 100, 100).length, n);
+        assert.equal(grid.queryBBox(-1, -1, 100, 100).length, n);
+    });
+
+});
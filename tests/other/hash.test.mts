@@ -0,0 +1,48 @@
+import assert from 'node:assert/strict';
+import { before, describe, it } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { fromWKT } from '../../src/io/WKT.mjs';
+import { hash } from '../../src/other/hash.mjs';
+
+
+describe('hash', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should return the same hash for identical geometries', () => {
+        const wkts = [
+            'POINT (1 2)',
+            'POINT Z (1 2 3)',
+            'POINT EMPTY',
+            'LINESTRING (0 0, 1 1)',
+            'POLYGON ((0 0, 1 0, 1 1, 0 0), (0.1 0.1, 0.2 0.1, 0.2 0.2, 0.1 0.1))',
+            'GEOMETRYCOLLECTION (POINT (1 2), LINESTRING (0 0, 1 1))',
+            'COMPOUNDCURVE (CIRCULARSTRING (0 0, 1 1, 2 0), (2 0, 3 0))',
+        ];
+        const a = hash(wkts.map(wkt => fromWKT(wkt)));
+        const b = hash(wkts.map(wkt => fromWKT(wkt)));
+        assert.deepEqual(a, b);
+        assert.equal(new Set(a).size, wkts.length);
+    });
+
+    it('should tell apart geometries that differ in type, dimension or coordinates', () => {
+        const hashes = hash([
+            point([ 1, 2 ]),
+            point([ 1, 2, 0 ]),
+            fromWKT('MULTIPOINT ((1 2))'),
+            lineString([ [ 0, 0 ], [ 1, 1 ] ]),
+            lineString([ [ 1, 1 ], [ 0, 0 ] ]),
+            fromWKT('LINEARRING (0 0, 1 0, 1 1, 0 0)'),
+            polygon([ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ]),
+        ]);
+        assert.equal(new Set(hashes).size, hashes.length);
+    });
+
+    it('should handle empty input', () => {
+        assert.deepEqual(hash([]), new Uint32Array());
+    });
+
+});
@@ -0,0 +1,62 @@
+import assert from 'node:assert/strict';
+import { before, describe, it } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { fromWKT } from '../../src/io/WKT.mjs';
+import { byteSize, heapStats } from '../../src/other/heap.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('heap', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    it('should estimate geometry byte size', () => {
+        const pt = byteSize(point([ 0, 0 ]));
+        const line3 = byteSize(lineString([ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ] ]));
+        const line4 = byteSize(lineString([ [ 0, 0 ], [ 1, 1 ], [ 2, 0 ], [ 3, 1 ] ]));
+        assert.ok(pt > 0);
+        assert.ok(line4 > line3);
+
+        const ring = [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ];
+        const poly = byteSize(polygon([ ring ]));
+        const polyWithHole = byteSize(polygon([ ring, ring ]));
+        assert.ok(polyWithHole > poly);
+
+        const collection = fromWKT('GEOMETRYCOLLECTION (POINT (0 0), POINT (0 0))');
+        assert.ok(byteSize(collection) > pt * 2);
+    });
+
+    it('should report heap stats', (t) => {
+        if (!geos.heap_stats) {
+            return t.skip('build without heap stats support');
+        }
+        const before = heapStats();
+        const geometries = Array.from({ length: 100 }, (_, i) => point([ i, i ]));
+        const after = heapStats();
+        assert.ok(after.allocations >= before.allocations + 100);
+        assert.ok(after.inUse > before.inUse);
+        assert.ok(after.heapSize >= after.inUse);
+        assert.ok(after.largestFree <= after.free);
+        for (const g of geometries) {
+            g.free();
+        }
+        assert.ok(heapStats().allocations < after.allocations);
+    });
+
+    it('should throw when build has no heap stats support', () => {
+        const { heap_stats } = geos;
+        geos.heap_stats = undefined;
+        try {
+            assert.throws(() => heapStats(), {
+                name: 'GEOSError',
+                message: 'Heap stats are available only in builds with GEOS_JS_MALLOC_HOOKS=ON',
+            });
+        } finally {
+            geos.heap_stats = heap_stats;
+        }
+    });
+
+});
@@ -0,0 +1,119 @@
+import assert from 'node:assert/strict';
+import { before, beforeEach, describe, it, type Mock, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { MemoryGrowthPolicy, memoryGrowthPolicy, memoryGrowthStats } from '../../src/other/memoryGrowth.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('memoryGrowthPolicy', () => {
+
+    let geos_memory_buffer_byteLength: Mock<() => typeof ArrayBuffer.prototype.byteLength>;
+    let geos_memory_grow: Mock<typeof WebAssembly.Memory.prototype.grow>;
+    let geos_updateMemory: Mock<typeof geos.updateMemory>;
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    beforeEach(() => {
+        geos_memory_buffer_byteLength?.mock.restore();
+        geos_memory_grow?.mock.restore();
+        geos_updateMemory?.mock.restore();
+
+        let byteLength = geos.memory.buffer.byteLength;
+        geos_memory_buffer_byteLength = mock.getter(geos.memory.buffer, 'byteLength');
+        geos_memory_grow = mock.method(geos.memory, 'grow', (delta) => {
+            const prevPageCount = byteLength / (64 * 1024);
+            byteLength += delta * (64 * 1024);
+            geos_memory_buffer_byteLength.mock.mockImplementation(() => byteLength);
+            return prevPageCount;
+        });
+        geos_updateMemory = mock.method(geos, 'updateMemory', () => undefined);
+        geos.m_g = new MemoryGrowthPolicy({}, byteLength);
+    });
+
+    // simulates Wasm growing the memory on its own, followed by the growth notification
+    const wasmGrowth = (pages: number) => {
+        geos.memory.grow(pages);
+        geos.m_g.onGrowth(geos);
+    };
+
+    it('should grow linearly by default', () => {
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 32 * 1024 * 1024); // 16MB + 16MB step
+        assert.deepEqual(geos_memory_grow.mock.calls[ 1 ].arguments, [ 255 ]);
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 48 * 1024 * 1024);
+        assert.equal(geos_updateMemory.mock.callCount(), 2);
+
+        const stats = memoryGrowthStats();
+        assert.equal(stats.count, 2);
+        assert.equal(stats.bytes, 32 * 1024 * 1024);
+        assert.ok(stats.time >= 0);
+    });
+
+    it('should grow geometrically with factor', () => {
+        memoryGrowthPolicy({ factor: 2 });
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 48 * 1024 * 1024); // ceil(16MB * 2 + 128KB) to 16MB step
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 112 * 1024 * 1024);
+        assert.equal(memoryGrowthStats().count, 2);
+        assert.equal(memoryGrowthStats().bytes, 96 * 1024 * 1024);
+    });
+
+    it('should respect maximum and report warning once, after the growth', async () => {
+        const onWarning = mock.fn();
+        memoryGrowthPolicy({ factor: 4, maximum: 32 * 1024 * 1024, warning: 20 * 1024 * 1024, onWarning });
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 32 * 1024 * 1024); // capped
+        assert.equal(onWarning.mock.callCount(), 0); // not from within the growth handler
+        await Promise.resolve();
+        assert.equal(onWarning.mock.callCount(), 1);
+        assert.deepEqual(onWarning.mock.calls[ 0 ].arguments, [ 32 * 1024 * 1024 ]);
+
+        wasmGrowth(1);
+        await Promise.resolve();
+        assert.equal(onWarning.mock.callCount(), 1);
+        assert.equal(memoryGrowthStats().count, 2);
+    });
+
+    it('should report overrun of maximum without throwing', async () => {
+        const onOverrun = mock.fn();
+        memoryGrowthPolicy({ maximum: 32 * 1024 * 1024, onOverrun });
+        wasmGrowth(1);
+        assert.equal(geos.memory.buffer.byteLength, 32 * 1024 * 1024);
+        assert.equal(memoryGrowthStats().overruns, 0);
+
+        wasmGrowth(2); // allocation that needs more than the maximum
+        assert.equal(geos.memory.buffer.byteLength, 32 * 1024 * 1024 + 2 * 64 * 1024); // no growth beyond the allocation
+        assert.equal(geos_memory_grow.mock.callCount(), 3);
+        assert.equal(memoryGrowthStats().overruns, 1);
+        assert.equal(onOverrun.mock.callCount(), 0);
+        await Promise.resolve();
+        assert.deepEqual(onOverrun.mock.calls[ 0 ].arguments, [ 32 * 1024 * 1024 + 2 * 64 * 1024 ]);
+    });
+
+    it('should not throw when memory cannot grow to the policy target', () => {
+        geos_memory_grow.mock.mockImplementation(() => {
+            throw new RangeError('WebAssembly.Memory.grow(): Maximum memory size exceeded');
+        });
+        geos.m_g.onGrowth(geos);
+        assert.equal(geos_updateMemory.mock.callCount(), 1);
+        assert.equal(memoryGrowthStats().count, 1);
+    });
+
+    it('should keep stats when policy changes', () => {
+        wasmGrowth(1);
+        memoryGrowthPolicy({ factor: 1.5 });
+        assert.equal(memoryGrowthStats().count, 1);
+        memoryGrowthPolicy(false);
+        assert.equal(memoryGrowthStats().bytes, 16 * 1024 * 1024);
+    });
+
+    it('should throw on invalid options', () => {
+        assert.throws(() => memoryGrowthPolicy({ factor: 0.5 }), { name: 'GEOSError', message: 'Invalid memory growth options' });
+        assert.throws(() => memoryGrowthPolicy({ step: 1024 }), { name: 'GEOSError', message: 'Invalid memory growth options' });
+    });
+
+});
@@ -0,0 +1,154 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { readFile } from 'node:fs/promises';
+import { GEOS_JS_WASM_PATH, initializeForTest } from '../tests-utils.mjs';
+import type { GeometryRef } from '../../src/geom/Geometry.mjs';
+import { point } from '../../src/helpers/helpers.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { area } from '../../src/measurement/area.mjs';
+import { fromWKT, toWKT } from '../../src/io/WKT.mjs';
+import { strTreeIndex } from '../../src/spatial-indexes/STRTree.mjs';
+import { pointGridIndex } from '../../src/spatial-indexes/PointGrid.mjs';
+import { createPool } from '../../src/other/pool.mjs';
+import { beginArena, resetArena } from '../../src/other/arena.mjs';
+import { POINTER } from '../../src/core/symbols.mjs';
+import { activate, geos, instantiateDetached } from '../../src/core/geos.mjs';
+
+
+describe('pool', () => {
+
+    let module: WebAssembly.Module;
+
+    before(async () => {
+        await initializeForTest();
+        module = await WebAssembly.compile(await readFile(GEOS_JS_WASM_PATH) as Buffer<ArrayBuffer>);
+    });
+
+    it('should run on pool instances and restore the global instance', async () => {
+        const globalInstance = geos;
+        const outside = point([ 0, 0 ]);
+        const pool = await createPool(module, { size: 2 });
+
+        const instances = new Set<typeof geos>();
+        let inside: GeometryRef | undefined;
+        for (let i = 0; i < 4; i++) {
+            const wkt = pool.run(() => {
+                instances.add(geos);
+                inside = fromWKT('POINT (1 2)');
+                return toWKT(inside);
+            });
+            assert.equal(wkt, 'POINT (1 2)');
+            assert.equal(inside!.detached, true);
+        }
+
+        assert.equal(instances.size, 2);
+        assert.equal(instances.has(globalInstance), false);
+        assert.equal(geos, globalInstance);
+        assert.equal(toWKT(outside), 'POINT (0 0)');
+        assert.deepEqual(pool.stats(), { size: 2, runs: 4, recycles: 0, recycleTime: 0 });
+    });
+
+    it('should restore the global instance when fn throws', async () => {
+        const globalInstance = geos;
+        const pool = await createPool(module, { size: 1 });
+        assert.throws(() => pool.run(() => {
+            fromWKT('POINT (0 0)');
+            pool.run(() => 0);
+        }), { name: 'GEOSError', message: 'Pool runs cannot be nested' });
+        assert.equal(geos, globalInstance);
+        assert.throws(() => pool.run(() => fromWKT('POINT (0')), { name: 'GEOSError::ParseException' });
+        assert.equal(geos, globalInstance);
+    });
+
+    it('should allow nested runs on different instances', async () => {
+        const pool = await createPool(module, { size: 2 });
+        const outer = pool.run(() => {
+            const instance = geos;
+            const inner = pool.run(() => geos);
+            assert.equal(geos, instance);
+            return [ instance, inner ];
+        });
+        assert.notEqual(outer[ 0 ], outer[ 1 ]);
+    });
+
+    it('should keep arena state per instance', async (t) => {
+        if (!geos.arena_begin) {
+            return t.skip('build without arena support');
+        }
+        const pool = await createPool(module, { size: 1 });
+        beginArena();
+        try {
+            pool.run(() => {
+                beginArena(); // not the arena of the global instance
+                resetArena();
+            });
+        } finally {
+            resetArena();
+        }
+    });
+
+    it('should recycle instances to the initial memory', async () => {
+        const pool = await createPool(module, { size: 1, recycleAfter: 3 });
+        const heap = () => Array.from(geos.U8.subarray(geos.buff[ POINTER ], geos.buff[ POINTER ] + 64));
+        let initialHeap: number[] = [];
+        pool.run(() => {
+            initialHeap = heap();
+        });
+        for (let i = 0; i < 5; i++) {
+            const a = pool.run(() => area(buffer(point([ i, i ]), 1)));
+            assert.ok(a > 3);
+        }
+        const stats = pool.stats();
+        assert.equal(stats.runs, 6);
+        assert.equal(stats.recycles, 2);
+
+        pool.recycle();
+        pool.run(() => {
+            assert.deepEqual(heap(), initialHeap);
+            assert.deepEqual(geos.t_w, {});
+            assert.equal(toWKT(point([ 3, 4 ])), 'POINT (3 4)');
+        });
+        assert.equal(pool.stats().recycles, 3);
+    });
+
+    it('should grow memory of the instance that allocates, not the active one', async () => {
+        const instance = await instantiateDetached(module);
+        const globalStats = { ...geos.m_g.stats };
+        const ptr = instance.malloc(instance.memory.buffer.byteLength); // does not fit, memory has to grow
+        try {
+            assert.equal(instance.U8.length, instance.memory.buffer.byteLength);
+            assert.equal(instance.m_g.stats.count, 1);
+            assert.deepEqual(geos.m_g.stats, globalStats);
+        } finally {
+            instance.free(ptr);
+        }
+    });
+
+    it('should free objects with the instance that created them', async () => {
+        const instance = await instantiateDetached(module);
+        const outer = activate(instance);
+        const pt = point([ 1, 1 ]);
+        const tree = strTreeIndex([ pt ]);
+        const grid = pointGridIndex(new Float64Array([ 1, 1 ]));
+        activate(outer);
+
+        const fns = [ 'GEOSGeom_destroy', 'STRtree_destroy', 'PointGrid_destroy' ] as const;
+        const active = fns.map(fn => mock.method(geos, fn));
+        const owner = fns.map(fn => mock.method(instance, fn));
+        try {
+            pt.free();
+            tree.free();
+            grid.free();
+            assert.deepEqual(active.map(fn => fn.mock.callCount()), [ 0, 0, 0 ]);
+            assert.deepEqual(owner.map(fn => fn.mock.callCount()), [ 1, 1, 1 ]);
+        } finally {
+            [ ...active, ...owner ].forEach(fn => fn.mock.restore());
+        }
+    });
+
+    it('should throw on invalid options', async () => {
+        await assert.rejects(createPool(module, { size: 0 }), { name: 'GEOSError', message: 'Invalid pool options' });
+        await assert.rejects(createPool(module, { recycleAfter: 0 }), { name: 'GEOSError', message: 'Invalid pool options' });
+    });
+
+});
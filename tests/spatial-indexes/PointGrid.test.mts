@@ -0,0 +1,147 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { pointGridIndex, PointGridRef } from '../../src/spatial-indexes/PointGrid.mjs';
+import { POINTER } from '../../src/core/symbols.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('point grid', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    const randomCoords = (n: number, size: number) => Float64Array.from(
+        { length: n * 2 },
+        () => Math.floor(Math.random() * size),
+    );
+
+    const sorted = (a: Uint32Array) => Array.from(a).sort((a, b) => a - b);
+
+    describe('destruct', () => {
+
+        it('should destroy instance when free() method is called', () => {
+            const destroy = mock.method(geos, 'PointGrid_destroy');
+
+            const grid = pointGridIndex(new Float64Array());
+            assert.ok(grid instanceof PointGridRef);
+            assert.ok(!grid.detached);
+            grid.free();
+            assert.ok(grid.detached);
+            assert.equal(destroy.mock.callCount(), 1);
+            assert.deepEqual(destroy.mock.calls[ 0 ].arguments, [ grid[ POINTER ] ]);
+        });
+
+    });
+
+    describe('construct', () => {
+
+        it('should create new PointGridRef instance', () => {
+            assert.equal(pointGridIndex(new Float64Array()).size, 0);
+            assert.equal(pointGridIndex(new Float64Array([ 1, 2, 3, 4 ])).size, 2);
+            assert.equal(pointGridIndex(new Float64Array([ 1, 2, 3, 4 ]), { cellSize: 0.5 }).size, 2);
+            assert.equal(pointGridIndex(randomCoords(5_000, 100)).size, 5_000); // larger than reusable buffer
+        });
+
+        it('should throw on invalid input', () => {
+            assert.throws(() => pointGridIndex(new Float64Array([ 1, 2, 3 ])), {
+                name: 'GEOSError',
+                message: 'Coordinates array length must be a multiple of 2',
+            });
+            for (const cellSize of [ 0, -1, NaN, Infinity ]) {
+                assert.throws(() => pointGridIndex(new Float64Array([ 1, 2 ]), { cellSize }), {
+                    name: 'GEOSError',
+                    message: 'Cell size must be a positive number',
+                });
+            }
+        });
+
+    });
+
+    describe('queryBBox', () => {
+
+        it('should return empty array when the grid is empty', () => {
+            assert.deepEqual(pointGridIndex(new Float64Array()).queryBBox(0, 0, 1, 1), new Uint32Array());
+            const grid = pointGridIndex(new Float64Array([ NaN, 0, 1, Infinity ]));
+            assert.deepEqual(grid.queryBBox(-Infinity, -Infinity, Infinity, Infinity), new Uint32Array());
+        });
+
+        it('should return points inside the box', () => {
+            const coords = randomCoords(2_000, 1_000);
+            for (const cellSize of [ undefined, 1, 10, 5_000 ]) {
+                const grid = pointGridIndex(coords, { cellSize });
+                for (const [ xMin, yMin, xMax, yMax ] of [ [ 100, 200, 300, 250 ], [ -50, -50, 10, 10 ], [ 990, 990, 2000, 2000 ], [ 2000, 0, 3000, 1 ], [ 5, 5, 5, 5 ] ]) {
+                    const expected: number[] = [];
+                    for (let i = 0; i < coords.length / 2; i++) {
+                        const x = coords[ i * 2 ], y = coords[ i * 2 + 1 ];
+                        if (x >= xMin && x <= xMax && y >= yMin && y <= yMax) expected.push(i);
+                    }
+                    assert.deepEqual(sorted(grid.queryBBox(xMin, yMin, xMax, yMax)), expected);
+                }
+            }
+        });
+
+        it('should write indices into provided array', () => {
+            const grid = pointGridIndex(new Float64Array([ 0, 0, 5, 5, 10, 10 ]));
+            const out = new Uint32Array(3).fill(9);
+            assert.equal(grid.queryBBox(6, 6, 11, 11, out), 1);
+            assert.deepEqual(out, new Uint32Array([ 2, 9, 9 ]));
+            assert.equal(grid.queryBBox(-1, -1, 11, 11, out.subarray(0, 2)), 3);
+        });
+
+    });
+
+    describe('queryRadius', () => {
+
+        it('should return points within the radius', () => {
+            const coords = randomCoords(2_000, 1_000);
+            const grid = pointGridIndex(coords);
+            for (const [ x, y, r ] of [ [ 500, 500, 50 ], [ 0, 0, 100 ], [ -100, 500, 101 ], [ 10, 10, 0 ], [ 500, 500, 2000 ] ]) {
+                const expected: number[] = [];
+                for (let i = 0; i < coords.length / 2; i++) {
+                    const dx = coords[ i * 2 ] - x, dy = coords[ i * 2 + 1 ] - y;
+                    if (dx * dx + dy * dy <= r * r) expected.push(i);
+                }
+                assert.deepEqual(sorted(grid.queryRadius(x, y, r)), expected);
+            }
+        });
+
+    });
+
+    describe('nearest', () => {
+
+        it('should return empty array when the grid is empty', () => {
+            assert.deepEqual(pointGridIndex(new Float64Array()).nearest(0, 0, 3), new Uint32Array());
+        });
+
+        it('should return k nearest points sorted by distance', () => {
+            const coords = Float64Array.from({ length: 4_000 }, () => Math.random() * 1_000);
+            const grid = pointGridIndex(coords);
+            const dist = (i: number, x: number, y: number) => Math.hypot(coords[ i * 2 ] - x, coords[ i * 2 + 1 ] - y);
+            for (const [ x, y ] of [ [ 500, 500 ], [ 0, 0 ], [ -300, 1200 ], [ 5000, 5000 ], [ 999, 1 ] ]) {
+                for (const k of [ 1, 5, 50 ]) {
+                    const expected = Array.from({ length: coords.length / 2 }, (_, i) => dist(i, x, y))
+                        .sort((a, b) => a - b)
+                        .slice(0, k);
+                    const nearest = grid.nearest(x, y, k);
+                    assert.equal(nearest.length, k);
+                    assert.deepEqual(Array.from(nearest, i => dist(i, x, y)), expected);
+                }
+            }
+        });
+
+        it('should return all points when k exceeds the number of points', () => {
+            const grid = pointGridIndex(new Float64Array([ 0, 0, 3, 4, 4, 4 ]));
+            assert.deepEqual(grid.nearest(5, 5, 10), new Uint32Array([ 2, 1, 0 ]));
+            assert.deepEqual(grid.nearest(5, 5), new Uint32Array([ 2 ]));
+            assert.deepEqual(grid.nearest(5, 5, 0), new Uint32Array());
+
+            const out = new Uint32Array(2);
+            assert.equal(grid.nearest(5, 5, 10, out), 3);
+            assert.deepEqual(out, new Uint32Array([ 2, 1 ]));
+        });
+
+    });
+
+});
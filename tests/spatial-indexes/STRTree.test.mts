@@ -142,6 +142,182 @@ describe('(STR) R-tree', () => {
 
     });
 
+    describe('queryBBox', () => {
+
+        it('should return empty array when the tree is empty', () => {
+            let tree: STRTreeRef;
+
+            tree = strTreeIndex([]);
+            assert.deepEqual(tree.queryBBox(1, 1, 3, 3), []);
+            assert.deepEqual(tree.queryBBoxes(new Float64Array([ 1, 1, 3, 3 ])), [ [] ]);
+
+            tree = strTreeIndex([ polygon([]), point([]) ]);
+            assert.deepEqual(tree.queryBBox(-1, -1, 1, 1), []);
+            assert.deepEqual(tree.queryBBoxes(new Float64Array([ -1, -1, 1, 1 ])), [ [] ]);
+        });
+
+        it('should return the same matches as query with box geometry', () => {
+            const geometries = [
+                [ 24, 154 ], [ 238, 42 ], [ 161, 140 ], [ 146, 127 ], [ 3, 80 ], [ 29, 32 ],
+                [ 259, 122 ], [ 6, 31 ], [ 186, 29 ], [ 139, 68 ], [ 260, 188 ], [ 75, 100 ],
+                [ 202, 32 ], [ 231, 179 ], [ 120, 150 ], [ 38, 164 ], [ 112, 28 ], [ 292, 199 ],
+            ].map((pt, i) => buffer(point(pt), i % 12, { quadrantSegments: 2 }));
+            const tree = strTreeIndex(geometries, { nodeCapacity: 4 });
+            const byIndex = (a: Geometry, b: Geometry) => geometries.indexOf(a) - geometries.indexOf(b);
+
+            const boxes = [
+                [ 150, 100, 250, 200 ],
+                [ 0, 0, 50, 50 ],
+                [ 1000, 1000, 1001, 1001 ],
+                [ 0, 0, 300, 200 ],
+            ];
+            for (const [ xMin, yMin, xMax, yMax ] of boxes) {
+                const expected = tree.query(box([ xMin, yMin, xMax, yMax ])).sort(byIndex);
+                assert.deepEqual(tree.queryBBox(xMin, yMin, xMax, yMax).sort(byIndex), expected);
+            }
+
+            const matches = tree.queryBBoxes(new Float64Array(boxes.flat()));
+            assert.equal(matches.length, boxes.length);
+            for (let i = 0; i < boxes.length; i++) {
+                assert.deepEqual(matches[ i ].sort(byIndex), tree.query(box(boxes[ i ])).sort(byIndex));
+            }
+            assert.deepEqual(matches[ 2 ], []);
+            assert.equal(matches[ 3 ].length, geometries.length);
+        });
+
+        it('should handle degenerate boxes', () => {
+            const tree = strTreeIndex([
+                point([ 0, 0 ]), lineString([ [ 4, 0 ], [ 8, 1 ] ]),
+            ]);
+            assert.deepEqual(tree.queryBBox(0, 0, 0, 0), [ tree.geometries[ 0 ] ]);
+            assert.deepEqual(tree.queryBBox(5, -1, 5, 2), [ tree.geometries[ 1 ] ]);
+            assert.deepEqual(tree.queryBBoxes(new Float64Array()), []);
+        });
+
+        it('should throw on invalid bboxes array length', () => {
+            const tree = strTreeIndex([ point([ 0, 0 ]) ]);
+            assert.throws(() => tree.queryBBoxes(new Float64Array([ 0, 0, 1 ])), {
+                name: 'GEOSError',
+                message: 'Bounding boxes array length must be a multiple of 4',
+            });
+        });
+
+    });
+
+    describe('indices', () => {
+
+        const geometries = [
+            point([ 0, 2 ]), lineString([ [ 4, 2 ], [ 8, 2 ] ]),
+            point([ 0, 4 ]), point([ 4, 4 ]), point([ 8, 4 ]),
+        ];
+
+        it('should return indices of matched geometries', () => {
+            const tree = strTreeIndex(geometries);
+            const selector = box([ 2, 0, 6, 6 ]);
+            const sorted = (a: Uint32Array) => Array.from(a).sort((a, b) => a - b);
+
+            assert.deepEqual(sorted(tree.queryIndices(selector)), [ 1, 3 ]);
+            assert.deepEqual(sorted(tree.queryBBoxIndices(2, 0, 6, 6)), [ 1, 3 ]);
+            assert.deepEqual(sorted(tree.nearestAllIndices(point([ 0, 3 ]))), [ 0, 2 ]);
+            assert.deepEqual(tree.queryBBoxIndices(100, 100, 101, 101), new Uint32Array());
+            assert.deepEqual(strTreeIndex([]).nearestAllIndices(point([ 0, 0 ])), new Uint32Array());
+        });
+
+        it('should write indices into provided array', () => {
+            const tree = strTreeIndex(geometries);
+            const out = new Uint32Array(geometries.length).fill(9);
+
+            assert.equal(tree.queryBBoxIndices(-1, 1, 1, 5, out), 2);
+            assert.deepEqual(Array.from(out.subarray(0, 2)).sort(), [ 0, 2 ]);
+            assert.deepEqual(out.subarray(2), new Uint32Array([ 9, 9, 9 ]));
+
+            assert.equal(tree.queryIndices(box([ 2, 0, 6, 6 ]), out), 2);
+            assert.deepEqual(Array.from(out.subarray(0, 2)).sort(), [ 1, 3 ]);
+
+            assert.equal(tree.nearestAllIndices(point([ 9, 5 ]), out), 1);
+            assert.equal(out[ 0 ], 4);
+        });
+
+        it('should write only as many indices as fit into provided array', () => {
+            const tree = strTreeIndex(geometries);
+            const out = new Uint32Array(2);
+            assert.equal(tree.queryBBoxIndices(-10, -10, 10, 10, out), 5);
+            assert.equal(new Set(out).size, 2);
+        });
+
+        it('should reuse the result buffer between queries', () => {
+            const tree = strTreeIndex(geometries);
+            const [ g1, g2, g3 ] = [ box([ -10, -10, 10, 10 ]), box([ 2, 0, 6, 6 ]), point([ 0, 3 ]) ];
+            const malloc = mock.method(geos, 'malloc');
+            const first = tree.query(g1);
+            const second = tree.query(g2);
+            tree.nearestAll(g3);
+            assert.equal(first.length, 5);
+            assert.equal(second.length, 2);
+            assert.equal(malloc.mock.callCount(), 0);
+        });
+
+    });
+
+    describe('stats', () => {
+
+        it('should return undefined when created without stats option', () => {
+            const tree = strTreeIndex([ point([ 0, 0 ]) ]);
+            tree.queryBBox(-1, -1, 1, 1);
+            assert.equal(tree.stats(), undefined);
+            assert.doesNotThrow(() => tree.resetStats());
+        });
+
+        it('should count query traversal', () => {
+            const geometries = Array.from({ length: 100 }, (_, i) => point([ i % 10, Math.floor(i / 10) ]));
+            const tree = strTreeIndex(geometries, { nodeCapacity: 4, stats: true });
+
+            let stats = tree.stats()!;
+            assert.ok(stats.buildTime >= 0);
+            assert.equal(stats.queries, 0);
+            assert.equal(stats.nodesVisited, 0);
+
+            const matches = tree.queryBBox(2, 2, 3, 3);
+            assert.equal(matches.length, 4);
+            tree.query(box([ 0, 0, 9, 9 ]));
+            stats = tree.stats()!;
+            assert.equal(stats.queries, 2);
+            assert.equal(stats.matches, 4 + 100);
+            assert.ok(stats.leafCandidates >= stats.matches);
+            assert.ok(stats.nodesVisited > 0);
+            assert.equal(stats.distanceEvaluations, 0);
+
+            tree.nearest(point([ 5.1, 5.1 ]));
+            stats = tree.stats()!;
+            assert.equal(stats.queries, 3);
+            assert.equal(stats.matches, 4 + 100 + 1);
+            assert.ok(stats.distanceEvaluations > 0);
+
+            tree.resetStats();
+            stats = tree.stats()!;
+            assert.equal(stats.queries, 0);
+            assert.equal(stats.matches, 0);
+            assert.equal(stats.distanceEvaluations, 0);
+            assert.ok(stats.buildTime >= 0);
+        });
+
+        it('should return the same matches with and without stats', () => {
+            const geometries = Array.from({ length: 50 }, (_, i) => buffer(point([ i * 7 % 31, i * 3 % 17 ]), i % 4 + 1));
+            const treeA = strTreeIndex(geometries, { nodeCapacity: 3 });
+            const treeB = strTreeIndex(geometries, { nodeCapacity: 3, stats: true });
+            const byIndex = (a: Geometry, b: Geometry) => geometries.indexOf(a) - geometries.indexOf(b);
+            for (const bbox of [ [ 0, 0, 5, 5 ], [ 10, 3, 20, 8 ], [ -10, -10, -5, -5 ], [ 0, 0, 40, 40 ] ]) {
+                assert.deepEqual(
+                    treeB.query(box(bbox)).sort(byIndex),
+                    treeA.query(box(bbox)).sort(byIndex),
+                );
+            }
+            assert.deepEqual(strTreeIndex([ point([ 1, 1 ]) ], { stats: true }).queryBBox(0, 0, 2, 2).length, 1);
+            assert.deepEqual(strTreeIndex([], { stats: true }).queryBBox(0, 0, 2, 2), []);
+        });
+
+    });
+
     describe('nearest', () => {
 
         it('should return undefined when the tree is empty', () => {
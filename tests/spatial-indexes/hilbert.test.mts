@@ -0,0 +1,94 @@
+import assert from 'node:assert/strict';
+import { before, describe, it } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import { hilbertCodes, hilbertSort } from '../../src/spatial-indexes/hilbert.mjs';
+import { lineString, point } from '../../src/helpers/helpers.mjs';
+import { bounds } from '../../src/measurement/bounds.mjs';
+
+
+describe('hilbert', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    describe('hilbertCodes', () => {
+
+        it('should return empty array for empty input', () => {
+            assert.deepEqual(hilbertCodes([]), new Uint32Array());
+        });
+
+        it('should return codes of the extent corners', () => {
+            const codes = hilbertCodes([
+                point([ 0, 0 ]),
+                point([ 0, 10 ]),
+                point([ 10, 10 ]),
+                point([ 10, 0 ]),
+                point([]),
+            ]);
+            assert.equal(codes.length, 5);
+            assert.equal(codes[ 0 ], 0);
+            assert.equal(codes[ 3 ], 2 ** 32 - 1);
+            assert.equal(codes[ 4 ], 0); // empty
+            assert.ok(codes[ 0 ] < codes[ 1 ] && codes[ 1 ] < codes[ 2 ] && codes[ 2 ] < codes[ 3 ]);
+        });
+
+        it('should use bbox center of the geometry', () => {
+            const [ a, b ] = hilbertCodes([
+                lineString([ [ 0, 0 ], [ 4, 6 ] ]),
+                point([ 2, 3 ]),
+            ], [ 0, 0, 10, 10 ]);
+            assert.equal(a, b);
+        });
+
+        it('should clamp geometries outside the extent', () => {
+            const codes = hilbertCodes([ point([ -5, -5 ]), point([ 0, 0 ]), point([ 50, 0 ]), point([ 10, 0 ]) ], [ 0, 0, 10, 10 ]);
+            assert.equal(codes[ 0 ], codes[ 1 ]);
+            assert.equal(codes[ 2 ], codes[ 3 ]);
+        });
+
+        it('should handle degenerate extent', () => {
+            const codes = hilbertCodes([ point([ 1, 1 ]), point([ 1, 1 ]) ]);
+            assert.deepEqual(codes, new Uint32Array([ 0, 0 ]));
+        });
+
+        it('should throw on invalid extent', () => {
+            assert.throws(() => hilbertCodes([ point([ 1, 1 ]) ], [ 1, 0, 0, 1 ]), {
+                name: 'GEOSError',
+                message: 'Invalid extent',
+            });
+        });
+
+    });
+
+    describe('hilbertSort', () => {
+
+        it('should sort geometries by their codes', () => {
+            const geometries = Array.from({ length: 2_000 }, () => point([ Math.random() * 100, Math.random() * 100 ]));
+            const codes = hilbertCodes(geometries);
+            const sorted = hilbertSort(geometries);
+            assert.equal(sorted.length, geometries.length);
+            assert.deepEqual(new Set(sorted), new Set(geometries));
+            for (let i = 1; i < sorted.length; i++) {
+                assert.ok(codes[ geometries.indexOf(sorted[ i - 1 ]) ] <= codes[ geometries.indexOf(sorted[ i ]) ]);
+            }
+        });
+
+        it('should visit quadrants along the curve', () => {
+            const sorted = hilbertSort([ point([ 10, 0 ]), point([ 10, 10 ]), point([ 0, 10 ]), point([ 0, 0 ]) ]);
+            for (let i = 1; i < sorted.length; i++) {
+                const [ x1, y1 ] = bounds(sorted[ i - 1 ]), [ x2, y2 ] = bounds(sorted[ i ]);
+                assert.ok(x1 === x2 || y1 === y2); // consecutive quadrants are adjacent
+            }
+        });
+
+        it('should keep input order of equal codes and put empty geometries last', () => {
+            const geometries = [ point([]), point([ 5, 5 ]), point([ 1, 1 ]), point([ 5, 5 ]), point([]) ];
+            const sorted = hilbertSort(geometries);
+            assert.deepEqual(sorted, [ geometries[ 2 ], geometries[ 1 ], geometries[ 3 ], geometries[ 0 ], geometries[ 4 ] ]);
+            assert.notEqual(geometries[ 0 ], sorted[ 0 ]); // input is not modified
+        });
+
+    });
+
+});
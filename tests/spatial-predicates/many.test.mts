@@ -0,0 +1,160 @@
+import assert from 'node:assert/strict';
+import { before, describe, it, mock } from 'node:test';
+import { initializeForTest } from '../tests-utils.mjs';
+import type { Geometry } from '../../src/geom/Geometry.mjs';
+import { box, lineString, point, polygon } from '../../src/helpers/helpers.mjs';
+import { equals, equalsMany } from '../../src/spatial-predicates/equals.mjs';
+import { disjoint, disjointMany, intersects, intersectsMany, intersectsXY } from '../../src/spatial-predicates/intersects.mjs';
+import { contains, containsMany, containsXY, containsProperly, containsProperlyMany, within, withinMany } from '../../src/spatial-predicates/contains.mjs';
+import { coveredBy, coveredByMany, covers, coversMany } from '../../src/spatial-predicates/covers.mjs';
+import { crosses, crossesMany } from '../../src/spatial-predicates/crosses.mjs';
+import { overlaps, overlapsMany } from '../../src/spatial-predicates/overlaps.mjs';
+import { touches, touchesMany } from '../../src/spatial-predicates/touches.mjs';
+import { relatePattern, relatePatternMany } from '../../src/spatial-predicates/relate.mjs';
+import { isPrepared } from '../../src/predicates/isPrepared.mjs';
+import { autoPrepare, prepare } from '../../src/geom/PreparedGeometry.mjs';
+import { buffer } from '../../src/operations/buffer.mjs';
+import { fromWKT } from '../../src/io/WKT.mjs';
+import { geos } from '../../src/core/geos.mjs';
+
+
+describe('one-vs-many predicates', () => {
+
+    before(async () => {
+        await initializeForTest();
+    });
+
+    const pairs: [ (a: Geometry, b: Geometry) => boolean, (a: Geometry, bs: Geometry[]) => Uint8Array ][] = [
+        [ equals, equalsMany ],
+        [ intersects, intersectsMany ],
+        [ disjoint, disjointMany ],
+        [ contains, containsMany ],
+        [ containsProperly, containsProperlyMany ],
+        [ within, withinMany ],
+        [ covers, coversMany ],
+        [ coveredBy, coveredByMany ],
+        [ crosses, crossesMany ],
+        [ overlaps, overlapsMany ],
+        [ touches, touchesMany ],
+    ];
+
+    const makeCandidates = () => [
+        point([ 2, 2 ]), point([ 4, 2 ]), point([ 6, 6 ]), point([]),
+        lineString([ [ 0, 0 ], [ 4, 4 ] ]), lineString([ [ 4, 0 ], [ 4, 4 ] ]), lineString([ [ 5, 0 ], [ 9, 9 ] ]),
+        box([ 0, 0, 4, 4 ]), box([ 2, 2, 6, 6 ]), box([ 1, 1, 3, 3 ]), box([ 4, 0, 6, 4 ]), box([ -1, -1, 5, 5 ]),
+        polygon([]),
+    ];
+
+    it('should return the same results as single predicates', () => {
+        const bs = makeCandidates();
+        for (const a of makeCandidates()) {
+            for (const [ single, many ] of pairs) {
+                const expected = Uint8Array.from(bs, b => +single(a, b));
+                assert.deepEqual(many(a, bs), expected, `${many.name}(${a.type})`);
+            }
+            const expected = Uint8Array.from(bs, b => +relatePattern(a, b, 'T*T***T**'));
+            assert.deepEqual(relatePatternMany(a, bs, 'T*T***T**'), expected);
+        }
+    });
+
+    it('should prepare `a` only for the call', () => {
+        const a = box([ 0, 0, 4, 4 ]);
+        const prepareMock = mock.method(geos, 'GEOSPrepare');
+        const destroy = mock.method(geos, 'GEOSPreparedGeom_destroy');
+        try {
+            equalsMany(a, [ point([ 1, 1 ]) ]);
+            assert.equal(prepareMock.mock.callCount(), 0);
+            intersectsMany(a, [ point([ 1, 1 ]) ]);
+            assert.equal(isPrepared(a), false);
+            assert.equal(prepareMock.mock.callCount(), 1);
+            assert.equal(destroy.mock.callCount(), 1);
+            assert.equal(destroy.mock.calls[ 0 ].arguments[ 0 ], prepareMock.mock.calls[ 0 ].result);
+
+            prepare(a);
+            intersectsMany(a, [ point([ 1, 1 ]) ]);
+            assert.equal(isPrepared(a), true);
+            assert.equal(prepareMock.mock.callCount(), 2); // by `prepare` only
+            assert.equal(destroy.mock.callCount(), 1);
+        } finally {
+            prepareMock.mock.restore();
+            destroy.mock.restore();
+        }
+    });
+
+    it('should count the call as a use of `a` with auto prepare', () => {
+        autoPrepare({ minUses: 2 });
+        try {
+            const a = box([ 0, 0, 4, 4 ]);
+            intersectsMany(a, [ point([ 1, 1 ]) ]);
+            assert.equal(isPrepared(a), false);
+            intersectsMany(a, [ point([ 1, 1 ]) ]);
+            assert.equal(isPrepared(a), true);
+        } finally {
+            autoPrepare(false);
+        }
+    });
+
+    it('should handle empty and large input arrays', () => {
+        const a = buffer(point([ 0, 0 ]), 50);
+        assert.deepEqual(intersectsMany(a, []), new Uint8Array());
+
+        const bs = Array.from({ length: 3_000 }, (_, i) => point([ i % 100, Math.floor(i / 100) ])); // larger than reusable buffer
+        assert.deepEqual(containsMany(a, bs), Uint8Array.from(bs, b => +contains(a, b)));
+        assert.deepEqual(relatePatternMany(a, bs, 'T*****FF*'), Uint8Array.from(bs, b => +contains(a, b)));
+    });
+
+    it('should throw on unsupported geometry type', () => {
+        const a = fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)');
+        assert.throws(() => intersectsMany(point([ 0, 0 ]), [ point([ 1, 1 ]), a ]), {
+            name: 'GEOSError::UnsupportedOperationException',
+            message: 'Curved geometry types are not supported.',
+        });
+    });
+
+    describe('XY', () => {
+
+        it('should return the same results as contains/intersects with points', () => {
+            const zones = [
+                buffer(point([ 50, 50 ]), 30),
+                polygon([ [ [ 0, 0 ], [ 0, 40 ], [ 40, 40 ], [ 40, 0 ], [ 0, 0 ] ], [ [ 10, 10 ], [ 30, 10 ], [ 30, 30 ], [ 10, 30 ], [ 10, 10 ] ] ]),
+                lineString([ [ 0, 0 ], [ 100, 100 ] ]),
+            ];
+            // integer coordinates to hit boundaries often
+            const coords = Float64Array.from({ length: 2 * 3_000 }, () => Math.floor(Math.random() * 101));
+            const points = Array.from({ length: coords.length / 2 }, (_, i) => point([ coords[ i * 2 ], coords[ i * 2 + 1 ] ]));
+            for (const zone of zones) {
+                assert.deepEqual(containsXY(zone, coords), Uint8Array.from(points, p => +contains(zone, p)));
+                assert.deepEqual(intersectsXY(zone, coords), Uint8Array.from(points, p => +intersects(zone, p)));
+            }
+        });
+
+        it('should prepare `a` only for the call', () => {
+            const zone = box([ 0, 0, 4, 4 ]);
+            const destroy = mock.method(geos, 'GEOSPreparedGeom_destroy');
+            try {
+                assert.deepEqual(containsXY(zone, new Float64Array([ 1, 1, 5, 5 ])), new Uint8Array([ 1, 0 ]));
+                assert.equal(isPrepared(zone), false);
+                assert.equal(destroy.mock.callCount(), 1);
+                prepare(zone);
+                assert.deepEqual(intersectsXY(zone, new Float64Array([ 4, 4 ])), new Uint8Array([ 1 ]));
+                assert.equal(isPrepared(zone), true);
+                assert.equal(destroy.mock.callCount(), 1);
+            } finally {
+                destroy.mock.restore();
+            }
+        });
+
+        it('should handle empty input', () => {
+            assert.deepEqual(containsXY(box([ 0, 0, 1, 1 ]), new Float64Array()), new Uint8Array());
+        });
+
+        it('should throw on invalid coordinates array length', () => {
+            assert.throws(() => containsXY(box([ 0, 0, 1, 1 ]), new Float64Array([ 1, 2, 3 ])), {
+                name: 'GEOSError',
+                message: 'Coordinates array length must be a multiple of 2',
+            });
+        });
+
+    });
+
+});